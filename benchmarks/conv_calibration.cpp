@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+// Calibration of the cost model of signal::choose_conv_method.
+//
+// Prints the per-operation times (ns) of the direct, FFT and overlap-add
+// convolutions, as the SCICPP_CONV_COSTS_* definitions to pass to the
+// compiler (or to define before including scicpp).
+
+#include "scicpp/core.hpp"
+#include "scicpp/signal.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+using namespace scicpp;
+using namespace scicpp::signal;
+
+template <typename T>
+auto random_array(std::size_t n) {
+    if constexpr (meta::is_complex_v<T>) {
+        using namespace scicpp::operators;
+        using R = typename T::value_type;
+        return random::rand<R>(n) + std::complex<R>(0, 1) * random::rand<R>(n);
+    } else {
+        return random::rand<T>(n);
+    }
+}
+
+// Best of several runs, in nanoseconds
+template <class Func>
+double run_time(Func &&func) {
+    double best = 0.0;
+
+    for (int i = 0; i < 5; ++i) {
+        const auto t0 = std::chrono::steady_clock::now();
+        const auto res = func();
+        const auto t1 = std::chrono::steady_clock::now();
+        const auto t = std::chrono::duration<double, std::nano>(t1 - t0);
+
+        if (res.empty()) {
+            std::puts("Unexpected empty convolution");
+        }
+
+        best = (i == 0) ? t.count() : std::min(best, t.count());
+    }
+
+    return best;
+}
+
+// Time per operation fitted over a set of sizes
+template <ConvMethod method, typename T, class Ops>
+double fit(const std::vector<std::pair<std::size_t, std::size_t>> &sizes,
+           Ops &&ops) {
+    double total_time = 0.0;
+    double total_ops = 0.0;
+
+    for (const auto &[n, m] : sizes) {
+        const auto a = random_array<T>(n);
+        const auto v = random_array<T>(m);
+        total_time += run_time([&]() { return convolve<method>(a, v); });
+        total_ops += ops(n, m);
+    }
+
+    return total_time / total_ops;
+}
+
+template <typename T>
+void calibrate(const char *name) {
+    const auto direct = fit<DIRECT, T>(
+        {{100000, 8}, {100000, 64}, {20000, 512}, {4000, 4000}},
+        signal::detail::conv_direct_ops<FULL>);
+
+    const auto fft = fit<FFT, T>(
+        {{1000, 1000}, {10000, 1000}, {100000, 10000}, {200000, 200000}},
+        signal::detail::conv_fft_ops);
+
+    const auto oa = fit<OA, T>(
+        {{200000, 16}, {200000, 128}, {200000, 1024}, {200000, 8192}},
+        signal::detail::conv_oa_ops<FULL>);
+
+    std::printf(
+        "-DSCICPP_CONV_COSTS_%s=\"{%.3g,%.3g,%.3g}\"\n", name, direct, fft, oa);
+}
+
+int main() {
+    calibrate<float>("FLOAT");
+    calibrate<double>("DOUBLE");
+    calibrate<std::complex<float>>("CFLOAT");
+    calibrate<std::complex<double>>("CDOUBLE");
+}
@@ -12,6 +12,9 @@
 // #include <scicpp/core/print.b.cpp>
 // #include <scicpp/core/random.b.cpp>
 // #include <scicpp/signal/fft.b.cpp>
+// #include <scicpp/signal/filtering.b.cpp>
+// #include <scicpp/signal/fir_filter_design.b.cpp>
+// #include <scicpp/signal/resampling.b.cpp>
 // #include <scicpp/signal/convolve.b.cpp>
 // #include <scicpp/signal/waveforms.b.cpp>
 // #include <scicpp/signal/windows.b.cpp>
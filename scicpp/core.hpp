@@ -19,6 +19,7 @@
 #include "core/random.hpp"
 #include "core/range.hpp"
 #include "core/stats.hpp"
+#include "core/thread_pool.hpp"
 #include "core/tuple.hpp"
 #include "core/units/maths.hpp"
 #include "core/units/quantity.hpp"
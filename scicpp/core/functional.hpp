@@ -224,9 +224,15 @@ template <class Array, class UnaryPredicate>
 // filter_reduce
 //---------------------------------------------------------------------------------
 
+// Compiled for several instruction sets (see scicpp_target_clones),
+// as the blocks of the pairwise reductions (sum, mean, ...) run here.
 template <class InputIt, class UnaryPredicate, class BinaryOp, typename T>
-[[nodiscard]] constexpr scicpp_pure auto filter_reduce(
-    InputIt first, InputIt last, BinaryOp op, T init, UnaryPredicate filter) {
+[[nodiscard]] constexpr scicpp_pure scicpp_target_clones auto
+filter_reduce(InputIt first,
+              InputIt last,
+              BinaryOp op,
+              T init,
+              UnaryPredicate filter) {
     using IteratorType = typename std::iterator_traits<InputIt>::value_type;
     using ReturnType = std::invoke_result_t<BinaryOp, T, IteratorType>;
 
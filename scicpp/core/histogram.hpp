@@ -15,6 +15,7 @@
 #include "scicpp/core/units/quantity.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdlib>
 #include <type_traits>
@@ -136,6 +137,85 @@ constexpr bool NonUniformBins = false;
 constexpr bool Density = true;
 constexpr bool Count = false;
 
+namespace detail {
+
+// Binning kernels, compiled for several instruction sets
+// (see scicpp_target_clones).
+
+constexpr std::size_t bin_chunk = 256;
+
+template <class InputIt, typename T>
+scicpp_target_clones void
+uniform_bin_counts(InputIt first,
+                   InputIt last,
+                   const std::vector<T> &bins,
+                   std::vector<signed_size_t> &hist) {
+    using raw_t = typename units::representation_t<T>;
+
+    const auto step = bins[1] - bins[0];
+    scicpp_require(step > T{0});
+
+    auto n = std::size_t(std::distance(first, last));
+    std::array<raw_t, bin_chunk> pos;
+
+    while (n > 0) {
+        const auto len = std::min(n, bin_chunk);
+        auto it = first;
+
+        // Positions computed ahead of the increments, so the divisions
+        // vectorize.
+        for (std::size_t i = 0; i < len; ++i, ++it) {
+            pos[i] = units::value((T(*it) - bins.front()) / step);
+        }
+
+        for (std::size_t i = 0; i < len; ++i, ++first) {
+            if (pos[i] >= raw_t(hist.size())) {
+                if (almost_equal(T(*first), bins.back())) {
+                    // Last bin edge is included
+                    ++hist.back();
+                }
+
+                continue;
+            }
+
+            if (pos[i] >= raw_t{0}) {
+                ++hist[std::size_t(pos[i])];
+            }
+        }
+
+        n -= len;
+    }
+}
+
+template <class InputIt, typename T>
+scicpp_target_clones void bin_counts(InputIt first,
+                                     InputIt last,
+                                     const std::vector<T> &bins,
+                                     std::vector<signed_size_t> &hist) {
+    using raw_t = typename units::representation_t<T>;
+
+    for (; first != last; ++first) {
+        const auto it = std::upper_bound(bins.cbegin(), bins.cend(), *first);
+
+        if (it == bins.cend()) { // No bin found
+            if (almost_equal(T(*first), bins.back())) {
+                // Last bin edge is included
+                ++hist.back();
+            }
+
+            continue;
+        }
+
+        const auto pos = std::distance(bins.cbegin(), it) - 1;
+
+        if (static_cast<raw_t>(pos) >= raw_t{0}) {
+            ++hist[std::size_t(pos)];
+        }
+    }
+}
+
+} // namespace detail
+
 template <
     bool density = false,
     bool use_uniform_bins = false,
@@ -144,7 +224,6 @@ template <
     typename T = std::conditional_t<std::is_integral_v<ItTp>, double, ItTp>>
 auto histogram(InputIt first, InputIt last, const std::vector<T> &bins) {
     using namespace operators;
-    using raw_t = typename units::representation_t<T>;
 
     if (unlikely(bins.size() <= 1)) {
         if constexpr (density) {
@@ -165,48 +244,10 @@ auto histogram(InputIt first, InputIt last, const std::vector<T> &bins) {
     if constexpr (use_uniform_bins) {
         // No search required if uniformly distributed bins,
         // we can directly compute the index.
-
-        const auto step = bins[1] - bins[0];
-        scicpp_require(step > T{0});
-
-        for (; first != last; ++first) {
-            const auto pos = units::value((T(*first) - bins.front()) / step);
-
-            if (pos >= raw_t(hist.size())) {
-                if (almost_equal(T(*first), bins.back())) {
-                    // Last bin edge is included
-                    ++hist.back();
-                }
-
-                continue;
-            }
-
-            if (pos >= raw_t{0}) {
-                ++hist[std::size_t(pos)];
-            }
-        }
+        detail::uniform_bin_counts(first, last, bins, hist);
     } else {
         // This works for both uniform and non-uniform bins.
-
-        for (; first != last; ++first) {
-            const auto it =
-                std::upper_bound(bins.cbegin(), bins.cend(), *first);
-
-            if (it == bins.cend()) { // No bin found
-                if (almost_equal(T(*first), bins.back())) {
-                    // Last bin edge is included
-                    ++hist.back();
-                }
-
-                continue;
-            }
-
-            const auto pos = std::distance(bins.cbegin(), it) - 1;
-
-            if (static_cast<raw_t>(pos) >= raw_t{0}) {
-                ++hist[std::size_t(pos)];
-            }
-        }
+        detail::bin_counts(first, last, bins, hist);
     }
 
     // We only return the histogram for this overload,
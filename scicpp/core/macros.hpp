@@ -27,6 +27,28 @@ namespace scicpp {
 
 #define scicpp_pure __attribute__((pure))
 #define scicpp_const __attribute__((const))
+#define scicpp_noinline __attribute__((noinline))
+
+// Runtime CPU dispatch
+//
+// With GCC on x86-64 Linux, the hot kernels marked scicpp_target_clones are
+// compiled for x86-64-v4 (AVX-512), x86-64-v3 (AVX2, FMA) and the compilation
+// target, the best variant for the CPU being selected when the program is
+// loaded. A binary built for a baseline target (ex. -march=x86-64-v2) thus
+// runs at full speed on recent CPUs.
+//
+// Disabled if the compilation target already has AVX-512, or by defining
+// SCICPP_NO_RUNTIME_DISPATCH.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) &&         \
+    defined(__gnu_linux__) && !defined(__AVX512F__) &&                         \
+    !defined(SCICPP_NO_RUNTIME_DISPATCH)
+#define SCICPP_RUNTIME_DISPATCH
+#define scicpp_target_clones                                                   \
+    __attribute__((target_clones(                                              \
+        "arch=x86-64-v4", "arch=x86-64-v3", "default")))
+#else
+#define scicpp_target_clones
+#endif
 
 #define likely(x) __builtin_expect((x), 1)
 #define unlikely(x) __builtin_expect((x), 0)
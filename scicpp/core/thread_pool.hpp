@@ -0,0 +1,302 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#ifndef SCICPP_CORE_THREAD_POOL
+#define SCICPP_CORE_THREAD_POOL
+
+#include "scicpp/core/macros.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace scicpp {
+
+//---------------------------------------------------------------------------------
+// ThreadPool
+//
+// Persistent pool of worker threads with work stealing.
+//
+// Each worker owns a task queue: it pops its own tasks in LIFO order and,
+// when its queue is empty, steals tasks in FIFO order from the other workers.
+// Tasks pushed from a worker go to its own queue, tasks pushed from any other
+// thread are distributed round-robin.
+//
+// Threads waiting for the completion of a parallel_for execute pending tasks
+// instead of blocking, so parallel_for can be nested.
+//---------------------------------------------------------------------------------
+
+class ThreadPool {
+  public:
+    explicit ThreadPool(std::size_t nworkers = default_nworkers())
+        : m_queues(nworkers) {
+        for (auto &q : m_queues) {
+            q = std::make_unique<WorkQueue>();
+        }
+
+        m_workers.reserve(nworkers);
+
+        for (std::size_t i = 0; i < nworkers; ++i) {
+            m_workers.emplace_back([this, i]() { worker_loop(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(m_mtx);
+            m_stop = true;
+        }
+
+        m_cv.notify_all();
+
+        for (auto &thrd : m_workers) {
+            thrd.join();
+        }
+    }
+
+    // Number of worker threads (the calling thread is not counted)
+    std::size_t size() const { return m_workers.size(); }
+
+    // Call func(i) for i in [0, n).
+    //
+    // At most max_concurrency threads are used, including the calling thread
+    // (0 means all the workers of the pool plus the calling thread).
+    // Indices are scheduled dynamically by chunks of chunk_size consecutive
+    // indices (0 means an automatic chunk size).
+    template <class Func>
+    void parallel_for(signed_size_t n,
+                      Func &&func,
+                      std::size_t max_concurrency = 0,
+                      signed_size_t chunk_size = 0) {
+        if (n <= 0) {
+            return;
+        }
+
+        const auto nthreads =
+            std::min({max_concurrency == 0 ? size() + 1 : max_concurrency,
+                      size() + 1,
+                      std::size_t(n)});
+
+        if (chunk_size <= 0) {
+            chunk_size = std::max(signed_size_t(1),
+                                  n / (4 * signed_size_t(nthreads)));
+        }
+
+        // All the indices are processed through this single out-of-line
+        // function, so func is compiled once for all the threads: floating
+        // point contractions (FMA) are the same whatever the thread count.
+        const auto run_range = [&func](signed_size_t i0,
+                                       signed_size_t i1) scicpp_noinline {
+            for (auto i = i0; i < i1; ++i) {
+                func(i);
+            }
+        };
+
+        if (nthreads <= 1) {
+            run_range(0, n);
+            return;
+        }
+
+        struct State {
+            std::atomic<signed_size_t> next{0};
+            std::atomic<std::size_t> running{0};
+            std::mutex mtx;
+            std::condition_variable cv;
+            std::exception_ptr error = nullptr;
+        };
+
+        auto state = std::make_shared<State>();
+
+        const auto run_chunks = [state, n, chunk_size, run_range]() {
+            try {
+                for (auto i0 = state->next.fetch_add(chunk_size); i0 < n;
+                     i0 = state->next.fetch_add(chunk_size)) {
+                    run_range(i0, std::min(i0 + chunk_size, n));
+                }
+            } catch (...) {
+                std::lock_guard lock(state->mtx);
+
+                if (state->error == nullptr) {
+                    state->error = std::current_exception();
+                }
+
+                // Prevent the other threads to start new chunks
+                state->next = n;
+            }
+        };
+
+        state->running = nthreads - 1;
+
+        for (std::size_t i = 0; i < nthreads - 1; ++i) {
+            push([state, run_chunks]() {
+                run_chunks();
+
+                if (state->running.fetch_sub(1) == 1) {
+                    std::lock_guard lock(state->mtx);
+                    state->cv.notify_all();
+                }
+            });
+        }
+
+        run_chunks();
+
+        // Help the pool while waiting for the other chunks to complete
+        while (state->running > 0) {
+            if (!run_pending_task()) {
+                std::unique_lock lock(state->mtx);
+                state->cv.wait(lock, [&]() { return state->running == 0; });
+            }
+        }
+
+        if (state->error != nullptr) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+    static std::size_t default_nworkers() {
+        const auto ncores = std::size_t(std::thread::hardware_concurrency());
+        return ncores > 1 ? ncores - 1 : 0;
+    }
+
+  private:
+    using Task = std::function<void()>;
+
+    struct WorkQueue {
+        std::mutex mtx;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+    std::mutex m_mtx;
+    std::condition_variable m_cv;
+    std::atomic<std::size_t> m_ntasks{0};
+    std::atomic<std::size_t> m_next_queue{0};
+    bool m_stop = false;
+
+    // Index of the worker running on the current thread in the pool
+    // it belongs to (if any).
+    static auto &this_worker() {
+        thread_local std::pair<const ThreadPool *, std::size_t> worker{
+            nullptr, 0};
+        return worker;
+    }
+
+    bool is_worker(std::size_t &idx) const {
+        const auto [pool, i] = this_worker();
+        idx = i;
+        return pool == this;
+    }
+
+    void push(Task task) {
+        std::size_t idx = 0;
+
+        if (!is_worker(idx)) {
+            idx = m_next_queue.fetch_add(1) % m_queues.size();
+        }
+
+        {
+            std::lock_guard lock(m_queues[idx]->mtx);
+            m_queues[idx]->tasks.push_back(std::move(task));
+        }
+
+        {
+            std::lock_guard lock(m_mtx);
+            ++m_ntasks;
+        }
+
+        m_cv.notify_one();
+    }
+
+    bool pop_own(std::size_t idx, Task &task) {
+        auto &q = *m_queues[idx];
+        std::lock_guard lock(q.mtx);
+
+        if (q.tasks.empty()) {
+            return false;
+        }
+
+        task = std::move(q.tasks.back());
+        q.tasks.pop_back();
+        --m_ntasks;
+        return true;
+    }
+
+    bool steal(std::size_t idx, Task &task) {
+        for (std::size_t k = 1; k <= m_queues.size(); ++k) {
+            auto &q = *m_queues[(idx + k) % m_queues.size()];
+            std::lock_guard lock(q.mtx);
+
+            if (!q.tasks.empty()) {
+                task = std::move(q.tasks.front());
+                q.tasks.pop_front();
+                --m_ntasks;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool try_pop(std::size_t idx, Task &task) {
+        return pop_own(idx, task) || steal(idx, task);
+    }
+
+    bool run_pending_task() {
+        if (m_queues.empty()) {
+            return false;
+        }
+
+        std::size_t idx = 0;
+        Task task;
+
+        if (is_worker(idx) ? try_pop(idx, task) : steal(idx, task)) {
+            task();
+            return true;
+        }
+
+        return false;
+    }
+
+    void worker_loop(std::size_t idx) {
+        this_worker() = {this, idx};
+
+        while (true) {
+            Task task;
+
+            if (try_pop(idx, task)) {
+                task();
+                continue;
+            }
+
+            std::unique_lock lock(m_mtx);
+            m_cv.wait(lock, [&]() { return m_stop || m_ntasks > 0; });
+
+            if (m_stop && m_ntasks == 0) {
+                return;
+            }
+        }
+    }
+}; // class ThreadPool
+
+// Library-wide thread pool shared by the parallel kernels
+inline ThreadPool &global_thread_pool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+} // namespace scicpp
+
+#endif // SCICPP_CORE_THREAD_POOL
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace scicpp {
+
+TEST_CASE("ThreadPool") {
+    SECTION("Size") {
+        REQUIRE(ThreadPool(0).size() == 0);
+        REQUIRE(ThreadPool(3).size() == 3);
+    }
+
+    SECTION("No workers") {
+        ThreadPool pool(0);
+        std::vector<int> v(100, 0);
+        pool.parallel_for(100, [&](auto i) { v[std::size_t(i)] = int(i); });
+
+        for (std::size_t i = 0; i < v.size(); ++i) {
+            REQUIRE(v[i] == int(i));
+        }
+    }
+
+    SECTION("All indices visited once") {
+        ThreadPool pool(4);
+
+        for (signed_size_t chunk : {0, 1, 3, 1000}) {
+            std::vector<std::atomic<int>> cnt(1000);
+            pool.parallel_for(
+                1000, [&](auto i) { ++cnt[std::size_t(i)]; }, 0, chunk);
+
+            for (const auto &c : cnt) {
+                REQUIRE(c == 1);
+            }
+        }
+    }
+
+    SECTION("Max concurrency") {
+        ThreadPool pool(4);
+        std::atomic<int> active{0};
+        std::atomic<int> max_active{0};
+
+        pool.parallel_for(
+            64,
+            [&](auto /* unused */) {
+                const auto a = ++active;
+                auto m = max_active.load();
+
+                while (a > m && !max_active.compare_exchange_weak(m, a)) {
+                }
+
+                std::this_thread::yield();
+                --active;
+            },
+            2,
+            1);
+
+        REQUIRE(max_active <= 2);
+    }
+
+    SECTION("Nested parallel_for") {
+        ThreadPool pool(3);
+        std::atomic<signed_size_t> sum{0};
+
+        pool.parallel_for(8, [&](auto i) {
+            pool.parallel_for(8, [&](auto j) { sum += i * 8 + j; });
+        });
+
+        REQUIRE(sum == 63 * 64 / 2);
+    }
+
+    SECTION("Exception") {
+        ThreadPool pool(2);
+
+        REQUIRE_THROWS_AS(pool.parallel_for(16,
+                                            [&](auto i) {
+                                                if (i == 7) {
+                                                    throw std::runtime_error(
+                                                        "Error");
+                                                }
+                                            }),
+                          std::runtime_error);
+
+        // The pool is still usable after an exception
+        std::atomic<int> cnt{0};
+        pool.parallel_for(16, [&](auto /* unused */) { ++cnt; });
+        REQUIRE(cnt == 16);
+    }
+
+    SECTION("Global thread pool") {
+        REQUIRE(&global_thread_pool() == &global_thread_pool());
+        std::atomic<int> cnt{0};
+        global_thread_pool().parallel_for(16, [&](auto /* unused */) { ++cnt; });
+        REQUIRE(cnt == 16);
+    }
+}
+
+} // namespace scicpp
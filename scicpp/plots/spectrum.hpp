@@ -85,8 +85,9 @@ template <signal::SpectrumScaling scaling = signal::DENSITY,
           SpectrumPlotScale plot_scale = DECIBEL,
           typename Array1,
           typename Array2,
-          typename T = double>
-auto csd(signal::Spectrum<T> spec, const Array1 &x, const Array2 &y) {
+          typename T = double,
+          typename Detrend = signal::detrend::Constant>
+auto csd(signal::Spectrum<T, Detrend> spec, const Array1 &x, const Array2 &y) {
     using namespace operators;
     auto [f, Pxy] = spec.template csd<scaling>(x, y);
 
@@ -102,8 +103,9 @@ auto csd(signal::Spectrum<T> spec, const Array1 &x, const Array2 &y) {
 template <signal::SpectrumScaling scaling = signal::DENSITY,
           SpectrumPlotScale plot_scale = DECIBEL,
           typename Array,
-          typename T = double>
-auto psd(signal::Spectrum<T> spec, const Array &x) {
+          typename T = double,
+          typename Detrend = signal::detrend::Constant>
+auto psd(signal::Spectrum<T, Detrend> spec, const Array &x) {
     using namespace operators;
 
     auto [f, Pxx] = spec.template welch<scaling>(x);
@@ -117,8 +119,13 @@ auto psd(signal::Spectrum<T> spec, const Array &x) {
     }
 }
 
-template <typename Array1, typename Array2, typename T = double>
-auto cohere(signal::Spectrum<T> spec, const Array1 &x, const Array2 &y) {
+template <typename Array1,
+          typename Array2,
+          typename T = double,
+          typename Detrend = signal::detrend::Constant>
+auto cohere(signal::Spectrum<T, Detrend> spec,
+            const Array1 &x,
+            const Array2 &y) {
     using namespace operators;
     auto [f, Cxy] = spec.coherence(x, y);
     return detail::csdplot(std::move(f), std::move(Cxy));
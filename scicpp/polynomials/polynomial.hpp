@@ -159,7 +159,7 @@ auto polymul(const U &P1, const V &P2) {
 // Specialization for the default convolution method
 template <class U, class V>
 auto polymul(const U &P1, const V &P2) {
-    return polymul<signal::DIRECT>(P1, P2);
+    return polymul<signal::AUTO>(P1, P2);
 }
 
 //---------------------------------------------------------------------------------
@@ -313,10 +313,10 @@ auto polypow(const std::vector<T> &P, std::size_t pow) {
     return polymul(x, y);
 }
 
-// Specialization for the default convolution method (DIRECT)
+// Specialization for the default convolution method (AUTO)
 template <typename T>
 auto polypow(const std::vector<T> &P, std::size_t pow) {
-    return polypow<signal::DIRECT>(P, pow);
+    return polypow<signal::AUTO>(P, pow);
 }
 
 //---------------------------------------------------------------------------------
@@ -5,7 +5,12 @@
 #define SCICPP_SIGNAL_HEADER
 
 #include "signal/convolve.hpp"
+#include "signal/czt.hpp"
 #include "signal/fft.hpp"
+#include "signal/filtering.hpp"
+#include "signal/fir_filter_design.hpp"
+#include "signal/goertzel.hpp"
+#include "signal/resampling.hpp"
 #include "signal/spectral.hpp"
 #include "signal/waveforms.hpp"
 #include "signal/windows.hpp"
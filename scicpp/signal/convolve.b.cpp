@@ -41,6 +41,37 @@ NONIUS_BENCHMARK("signal::fftconvolve (double, 10000 x 1000)",
                          [&]() { return scicpp::signal::fftconvolve(a, v); });
                  })
 
+NONIUS_BENCHMARK("signal::convolve (double, 1000000 x 256)",
+                 [](nonius::chronometer meter) {
+                     const auto a = scicpp::random::rand<double>(1000000);
+                     const auto v = scicpp::random::rand<double>(256);
+
+                     meter.measure(
+                         [&]() { return scicpp::signal::convolve(a, v); });
+                 })
+
+NONIUS_BENCHMARK("signal::oaconvolve (double, 1000000 x 256)",
+                 [](nonius::chronometer meter) {
+                     const auto a = scicpp::random::rand<double>(1000000);
+                     const auto v = scicpp::random::rand<double>(256);
+
+                     meter.measure(
+                         [&]() { return scicpp::signal::oaconvolve(a, v); });
+                 })
+
+NONIUS_BENCHMARK("signal::convolve (complex, 100000 x 256)",
+                 [](nonius::chronometer meter) {
+                     using namespace scicpp::operators;
+                     using namespace std::complex_literals;
+                     const auto a = scicpp::random::rand<double>(100000) +
+                                    1.0i * scicpp::random::rand<double>(100000);
+                     const auto v = scicpp::random::rand<double>(256) +
+                                    1.0i * scicpp::random::rand<double>(256);
+
+                     meter.measure(
+                         [&]() { return scicpp::signal::convolve(a, v); });
+                 })
+
 // NONIUS_BENCHMARK("signal::convolve (float, 10000 x 1000)",
 //                  [](nonius::chronometer meter) {
 //                      const auto a = scicpp::random::rand<float>(10000);
@@ -57,4 +88,46 @@ NONIUS_BENCHMARK("signal::fftconvolve (double, 10000 x 1000)",
 
 //                      meter.measure(
 //                          [&]() { return scicpp::signal::fftconvolve(a, v); });
-//                  })
\ No newline at end of file
+//                  })
+NONIUS_BENCHMARK("signal::correlate (double, 4096 x 256, 32 templates)",
+                 [](nonius::chronometer meter) {
+                     const auto a = scicpp::random::rand<double>(4096);
+                     std::vector<std::vector<double>> templates;
+
+                     for (std::size_t k = 0; k < 32; ++k) {
+                         templates.push_back(
+                             scicpp::random::rand<double>(256));
+                     }
+
+                     meter.measure([&]() {
+                         std::vector<std::vector<double>> res;
+
+                         for (const auto &v : templates) {
+                             res.push_back(
+                                 scicpp::signal::correlate<
+                                     scicpp::signal::FFT>(a, v));
+                         }
+
+                         return res;
+                     });
+                 })
+
+NONIUS_BENCHMARK("signal::Correlator (double, 4096 x 256, 32 templates)",
+                 [](nonius::chronometer meter) {
+                     const auto a = scicpp::random::rand<double>(4096);
+                     std::vector<std::vector<double>> templates;
+
+                     for (std::size_t k = 0; k < 32; ++k) {
+                         templates.push_back(
+                             scicpp::random::rand<double>(256));
+                     }
+
+                     scicpp::signal::Correlator<double> correlator(
+                         templates, a.size());
+                     std::vector<std::vector<double>> res;
+
+                     meter.measure([&]() {
+                         correlator.correlate(a, res);
+                         return res.size();
+                     });
+                 })
@@ -8,11 +8,14 @@
 #include "scicpp/core/maths.hpp"
 #include "scicpp/core/meta.hpp"
 #include "scicpp/core/numeric.hpp"
+#include "scicpp/core/thread_pool.hpp"
 #include "scicpp/core/utils.hpp"
 #include "scicpp/signal/fft.hpp"
 
 #include <algorithm>
 #include <array>
+#include <cmath>
+#include <complex>
 #include <cstdlib>
 #include <type_traits>
 #include <utility>
@@ -20,7 +23,42 @@
 
 namespace scicpp::signal {
 
-enum ConvMethod : int { DIRECT, FFT };
+// AUTO selects DIRECT, FFT or OA from a cost model (see choose_conv_method)
+enum ConvMethod : int { DIRECT, FFT, OA, AUTO };
+
+// Output of a convolution of arrays of sizes n and m:
+// - FULL: The full discrete linear convolution, of size n + m - 1.
+// - SAME: Same size as the first input, centered with respect to FULL.
+// - VALID: Only the outputs that do not rely on zero-padding,
+//          of size max(n, m) - min(n, m) + 1.
+enum ConvMode : int { FULL, SAME, VALID };
+
+namespace detail {
+
+template <ConvMode mode>
+constexpr std::size_t conv_output_size(std::size_t n, std::size_t m) {
+    if constexpr (mode == FULL) {
+        return n + m - 1;
+    } else if constexpr (mode == SAME) {
+        return n;
+    } else { // mode == VALID
+        return std::max(n, m) - std::min(n, m) + 1;
+    }
+}
+
+// Index of the first output in the full convolution
+template <ConvMode mode>
+constexpr std::size_t conv_output_start(std::size_t n, std::size_t m) {
+    if constexpr (mode == FULL) {
+        return 0;
+    } else if constexpr (mode == SAME) {
+        return (m - 1) / 2;
+    } else { // mode == VALID
+        return std::min(n, m) - 1;
+    }
+}
+
+} // namespace detail
 
 //---------------------------------------------------------------------------------
 // direct_convolve
@@ -28,7 +66,35 @@ enum ConvMethod : int { DIRECT, FFT };
 
 namespace detail {
 
-// For now only the "full" mode is implemented
+// acc + x * y, without the NaN recovery of the complex multiplication
+// that prevents vectorization.
+template <typename T>
+constexpr T mul_add(T acc, T x, T y) {
+    if constexpr (meta::is_complex_v<T>) {
+        return {acc.real() + (x.real() * y.real() - x.imag() * y.imag()),
+                acc.imag() + (x.real() * y.imag() + x.imag() * y.real())};
+    } else {
+        return acc + x * y;
+    }
+}
+
+// i-th output of the full convolution of a and v
+template <class V, class W>
+constexpr auto full_convolve_at(const V &a, const W &v, signed_size_t i) {
+    const auto n = signed_size_t(a.size());
+    const auto m = signed_size_t(v.size());
+    const auto jmn = (i >= m - 1) ? i - (m - 1) : 0;
+    const auto jmx = (i < n - 1) ? i : n - 1;
+
+    typename V::value_type res{0};
+
+    for (auto j = jmn; j <= jmx; ++j) {
+        res += (a[std::size_t(j)] * v[std::size_t(i - j)]);
+    }
+
+    return res;
+}
+
 // https://stackoverflow.com/questions/24518989/how-to-perform-1-dimensional-valid-convolution
 template <class U, class V, class W>
 constexpr void direct_convolve_impl(U &res, const V &a, const W &v) {
@@ -42,39 +108,258 @@ constexpr void direct_convolve_impl(U &res, const V &a, const W &v) {
     scicpp_require(signed_size_t(res.size()) == n + m - 1);
 
     for (signed_size_t i = 0; i < n + m - 1; ++i) {
-        res[std::size_t(i)] = 0.0;
-        const auto jmn = (i >= m - 1) ? i - (m - 1) : 0;
-        const auto jmx = (i < n - 1) ? i : n - 1;
-        for (auto j = jmn; j <= jmx; ++j) {
-            res[std::size_t(i)] += (a[std::size_t(j)] * v[std::size_t(i - j)]);
+        res[std::size_t(i)] = full_convolve_at(a, v, i);
+    }
+}
+
+// Correlation of x with the kernel h of size m:
+//     res[i] = sum_k x[i + k] * h[k], for i in [0, nres),
+// where x holds nres + m - 1 values.
+//
+// Outputs are computed by tiles of conv_tile consecutive values accumulated
+// in registers, so that each kernel coefficient is loaded once per tile and
+// the loop over the tile vectorizes.
+// Outputs are processed by blocks, and the kernel by chunks, such that a
+// kernel chunk and the input window of an output block stay in the L1 cache.
+// The terms of each output are summed by increasing k, as the scalar loop.
+
+constexpr std::size_t conv_tile = 32;
+constexpr std::size_t conv_output_block = 32 * conv_tile;
+constexpr std::size_t conv_kernel_block = 1024;
+
+template <typename T>
+scicpp_target_clones void correlate_tiled_real(
+    const T *x, std::size_t nres, const T *h, std::size_t m, T *res) {
+    for (std::size_t i0 = 0; i0 < nres; i0 += conv_output_block) {
+        const auto i1 = std::min(i0 + conv_output_block, nres);
+
+        for (std::size_t k0 = 0; k0 < m; k0 += conv_kernel_block) {
+            const auto k1 = std::min(k0 + conv_kernel_block, m);
+            auto i = i0;
+
+            for (; i + conv_tile <= i1; i += conv_tile) {
+                std::array<T, conv_tile> acc{};
+
+                if (k0 > 0) {
+                    std::copy_n(res + i, conv_tile, acc.begin());
+                }
+
+                for (auto k = k0; k < k1; ++k) {
+                    const auto hk = h[k];
+                    const auto xk = x + i + k;
+
+                    for (std::size_t t = 0; t < conv_tile; ++t) {
+                        acc[t] = acc[t] + xk[t] * hk;
+                    }
+                }
+
+                std::copy(acc.cbegin(), acc.cend(), res + i);
+            }
+
+            for (; i < i1; ++i) {
+                auto acc = (k0 > 0) ? res[i] : T{0};
+
+                for (auto k = k0; k < k1; ++k) {
+                    acc = acc + x[i + k] * h[k];
+                }
+
+                res[i] = acc;
+            }
+        }
+    }
+}
+
+// Interleaved complex multiplications don't vectorize well,
+// so the kernel and the input window of each output block
+// are split into real and imaginary parts.
+template <typename T>
+scicpp_target_clones void correlate_tiled_complex(const std::complex<T> *x,
+                                                  std::size_t nres,
+                                                  const std::complex<T> *h,
+                                                  std::size_t m,
+                                                  std::complex<T> *res) {
+    std::vector<T> hr(m), hi(m);
+    std::vector<T> xr(conv_output_block + m - 1), xi(xr.size());
+
+    for (std::size_t k = 0; k < m; ++k) {
+        hr[k] = h[k].real();
+        hi[k] = h[k].imag();
+    }
+
+    for (std::size_t i0 = 0; i0 < nres; i0 += conv_output_block) {
+        const auto i1 = std::min(i0 + conv_output_block, nres);
+
+        for (std::size_t j = 0; j < i1 - i0 + m - 1; ++j) {
+            xr[j] = x[i0 + j].real();
+            xi[j] = x[i0 + j].imag();
+        }
+
+        for (std::size_t k0 = 0; k0 < m; k0 += conv_kernel_block) {
+            const auto k1 = std::min(k0 + conv_kernel_block, m);
+            auto i = i0;
+
+            for (; i + conv_tile <= i1; i += conv_tile) {
+                std::array<T, conv_tile> acc_r{};
+                std::array<T, conv_tile> acc_i{};
+
+                if (k0 > 0) {
+                    for (std::size_t t = 0; t < conv_tile; ++t) {
+                        acc_r[t] = res[i + t].real();
+                        acc_i[t] = res[i + t].imag();
+                    }
+                }
+
+                for (auto k = k0; k < k1; ++k) {
+                    const auto hrk = hr[k];
+                    const auto hik = hi[k];
+                    const auto xrk = xr.data() + (i - i0) + k;
+                    const auto xik = xi.data() + (i - i0) + k;
+
+                    for (std::size_t t = 0; t < conv_tile; ++t) {
+                        acc_r[t] = acc_r[t] + (xrk[t] * hrk - xik[t] * hik);
+                        acc_i[t] = acc_i[t] + (xrk[t] * hik + xik[t] * hrk);
+                    }
+                }
+
+                for (std::size_t t = 0; t < conv_tile; ++t) {
+                    res[i + t] = {acc_r[t], acc_i[t]};
+                }
+            }
+
+            for (; i < i1; ++i) {
+                auto acc = (k0 > 0) ? res[i] : std::complex<T>{0};
+
+                for (auto k = k0; k < k1; ++k) {
+                    acc = mul_add(acc, x[i + k], h[k]);
+                }
+
+                res[i] = acc;
+            }
         }
     }
 }
 
-template <typename T, std::size_t N, std::size_t M>
+template <typename T>
+void correlate_tiled(
+    const T *x, std::size_t nres, const T *h, std::size_t m, T *res) {
+    if constexpr (meta::is_complex_v<T>) {
+        correlate_tiled_complex(x, nres, h, m, res);
+    } else {
+        correlate_tiled_real(x, nres, h, m, res);
+    }
+}
+
+// Outputs [start, start + res.size()) of the full convolution of x and v,
+// where v is not longer than x.
+template <typename T>
+void direct_convolve_range(std::vector<T> &res,
+                           const std::vector<T> &x,
+                           const std::vector<T> &v,
+                           std::size_t start) {
+    const auto n = x.size();
+    const auto m = v.size();
+    const auto stop = start + res.size();
+    scicpp_require(m <= n);
+
+    // Interior outputs [m - 1, n), where v fully overlaps x
+    const auto i0 = std::clamp(m - 1, start, stop);
+    const auto i1 = std::clamp(n, i0, stop);
+
+    // Convolution is a correlation with the reversed kernel
+    const std::vector<T> h(v.crbegin(), v.crend());
+
+    // Edge outputs [first, last) are computed by the same kernel on a
+    // zero-padded copy of the x samples they overlap.
+    // Edge tiles are aligned on the full convolution indices 0 and n
+    // (outputs [e0, e1) are computed), so an output is computed the same way
+    // (tile or remaining output, which may not be contracted the same way)
+    // whatever the mode.
+    const auto edge = [&](std::size_t e0,
+                          std::size_t e1,
+                          std::size_t first,
+                          std::size_t last) {
+        // Short kernels have no edge tile: the scalar loop gives the same
+        // outputs without the copies.
+        if (m <= conv_tile) {
+            for (auto i = first; i < last; ++i) {
+                res[i - start] = full_convolve_at(x, v, signed_size_t(i));
+            }
+
+            return;
+        }
+
+        // x samples [e0 - (m - 1), e1), zero outside of x
+        const auto j0 = signed_size_t(e0) - signed_size_t(m - 1);
+        std::vector<T> xpad(e1 - e0 + m - 1, T{0});
+
+        for (std::size_t k = 0; k < xpad.size(); ++k) {
+            const auto j = j0 + signed_size_t(k);
+
+            if (j >= 0 && j < signed_size_t(n)) {
+                xpad[k] = x[std::size_t(j)];
+            }
+        }
+
+        std::vector<T> tmp(e1 - e0);
+        correlate_tiled(xpad.data(), e1 - e0, h.data(), m, tmp.data());
+        std::copy(tmp.cbegin() + signed_size_t(first - e0),
+                  tmp.cbegin() + signed_size_t(last - e0),
+                  res.begin() + signed_size_t(first - start));
+    };
+
+    if (i0 > start) {
+        edge(start - start % conv_tile, m - 1, start, i0);
+    }
+
+    if (i1 > i0) {
+        correlate_tiled(
+            x.data() + (i0 - (m - 1)), i1 - i0, h.data(), m, &res[i0 - start]);
+    }
+
+    if (stop > i1) {
+        const auto e1 = n + (stop - n + conv_tile - 1) / conv_tile * conv_tile;
+        edge(i1 - (i1 - n) % conv_tile, std::min(e1, n + m - 1), i1, stop);
+    }
+}
+
+template <ConvMode mode = FULL, typename T, std::size_t N, std::size_t M>
 constexpr auto direct_convolve(const std::array<T, N> &a,
                                const std::array<T, M> &v) {
-    std::array<T, N + M - 1> res{};
+    std::array<T, N + M - 1> full{};
 
     if constexpr (M <= N) {
-        detail::direct_convolve_impl(res, a, v);
+        detail::direct_convolve_impl(full, a, v);
     } else {
-        detail::direct_convolve_impl(res, v, a);
+        detail::direct_convolve_impl(full, v, a);
     }
 
-    return res;
+    if constexpr (mode == FULL) {
+        return full;
+    } else {
+        constexpr auto start = conv_output_start<mode>(N, M);
+        std::array<T, conv_output_size<mode>(N, M)> res{};
+
+        for (std::size_t i = 0; i < res.size(); ++i) {
+            res[i] = full[start + i];
+        }
+
+        return res;
+    }
 }
 
-template <typename T>
+template <ConvMode mode = FULL, typename T>
 auto direct_convolve(const std::vector<T> &a, const std::vector<T> &v) {
-    std::vector<T> res(a.size() + v.size() - 1);
+    scicpp_require(!a.empty() && !v.empty());
+
+    std::vector<T> res(conv_output_size<mode>(a.size(), v.size()));
+    const auto start = conv_output_start<mode>(a.size(), v.size());
 
     // Same behavior as numpy:
     // If v is longer than a, the arrays are swapped before computation.
     if (v.size() <= a.size()) {
-        detail::direct_convolve_impl(res, a, v);
+        detail::direct_convolve_range(res, a, v, start);
     } else {
-        detail::direct_convolve_impl(res, v, a);
+        detail::direct_convolve_range(res, v, a, start);
     }
 
     return res;
@@ -86,23 +371,275 @@ auto direct_convolve(const std::vector<T> &a, const std::vector<T> &v) {
 // fftconvolve
 //---------------------------------------------------------------------------------
 
-template <typename T>
+template <ConvMode mode = FULL, typename T>
 auto fftconvolve(const std::vector<T> &a, const std::vector<T> &v) {
     using namespace scicpp::operators;
 
     const auto res_size = a.size() + v.size() - 1;
-    const auto fft_size = next_fast_len(res_size);
-    const auto a_pad = zero_padding(a, fft_size);
-    const auto v_pad = zero_padding(v, fft_size);
+    const auto fft_size = int(next_fast_len(res_size));
+
+    const auto keep_outputs = [&](auto &&res) {
+        const auto start = detail::conv_output_start<mode>(a.size(), v.size());
+        res.erase(res.begin(), res.begin() + signed_size_t(start));
+        res.resize(detail::conv_output_size<mode>(a.size(), v.size()));
+        return std::move(res);
+    };
 
     if constexpr (meta::is_complex_v<T>) {
-        auto res = ifft(fft(a_pad) * fft(v_pad), int(fft_size));
-        res.resize(res_size);
-        return res;
+        return keep_outputs(
+            ifft(fft(a, fft_size) * fft(v, fft_size), fft_size));
     } else {
-        auto res = irfft(rfft(a_pad) * rfft(v_pad), int(fft_size));
-        res.resize(res_size);
-        return res;
+        return keep_outputs(
+            irfft(rfft(a, fft_size) * rfft(v, fft_size), fft_size));
+    }
+}
+
+//---------------------------------------------------------------------------------
+// oaconvolve
+//
+// Block convolution of a long signal with a short kernel.
+//
+// The outputs are split into disjoint blocks of L = N - m + 1 samples,
+// where N is the FFT size and m the kernel size. Each block is computed by
+// overlap-save: the N input samples ending at the last output of the block
+// are transformed, multiplied by the kernel spectrum, and the last L samples
+// of the inverse transform are kept.
+//
+// The kernel spectrum is computed once, and the blocks are independent,
+// so they can be computed in parallel without any reduction.
+//---------------------------------------------------------------------------------
+
+namespace detail {
+
+// FFT size minimizing the cost per output sample N log(N) / (N - m + 1).
+// Only multiples of 4 are considered since the real FFT of kissfft falls back
+// to a full complex FFT for other sizes.
+inline std::size_t oa_fft_size(std::size_t m) {
+    const auto cost = [m](std::size_t N) {
+        return double(N) * std::log2(double(N)) / double(N - m + 1);
+    };
+
+    const auto N_min = std::max(std::size_t(2) * m, std::size_t(64));
+    const auto N_max = std::size_t(64) * N_min;
+    std::size_t N_best = 0;
+
+    for (const auto N : Hamming<std::size_t, 3>({2, 3, 5})) {
+        if (N > N_max) {
+            break;
+        }
+
+        if (N >= N_min && N % 4 == 0 &&
+            (N_best == 0 || cost(N) < cost(N_best))) {
+            N_best = N;
+        }
+    }
+
+    return N_best;
+}
+
+// Outputs [start, start + res.size()) of the full convolution of x and v,
+// where v is not longer than x.
+template <typename T>
+void oaconvolve_range(std::vector<T> &res,
+                      const std::vector<T> &x,
+                      const std::vector<T> &v,
+                      std::size_t start,
+                      std::size_t nthreads) {
+    using namespace scicpp::operators;
+
+    const auto n = signed_size_t(x.size());
+    const auto m = v.size();
+    const auto N = oa_fft_size(m);
+    const auto L = N - m + 1;
+    const auto nblocks = signed_size_t((res.size() + L - 1) / L);
+
+    const auto H = [&]() {
+        if constexpr (meta::is_complex_v<T>) {
+            return fft(v, int(N));
+        } else {
+            return rfft(v, int(N));
+        }
+    }();
+
+    using R = typename decltype(H)::value_type::value_type;
+
+    const auto convolve_block = [&](signed_size_t j) {
+        thread_local std::vector<T> block;
+        thread_local std::vector<std::complex<R>> spectrum;
+        block.resize(N);
+        spectrum.resize(H.size());
+
+        // Input samples [first, first + N), zero outside of x
+        const auto o0 = start + std::size_t(j) * L;
+        const auto first = signed_size_t(o0) - signed_size_t(m - 1);
+        const auto lo = std::clamp(-first, signed_size_t(0), signed_size_t(N));
+        const auto hi =
+            std::clamp(n - first, signed_size_t(0), signed_size_t(N));
+
+        std::fill(block.begin(), block.begin() + lo, T{0});
+        std::copy(x.cbegin() + first + lo,
+                  x.cbegin() + first + std::max(lo, hi),
+                  block.begin() + lo);
+        std::fill(block.begin() + std::max(lo, hi), block.end(), T{0});
+
+        if constexpr (meta::is_complex_v<T>) {
+            auto &engine = fft_engine<R>();
+            engine.fwd(spectrum.data(), block.data(), signed_size_t(N));
+            spectrum = std::move(spectrum) * H;
+            engine.inv(block.data(), spectrum.data(), signed_size_t(N));
+        } else {
+            auto &engine = fft_engine<R, true>();
+            engine.fwd(spectrum.data(), block.data(), signed_size_t(N));
+            spectrum = std::move(spectrum) * H;
+            engine.inv(block.data(), spectrum.data(), signed_size_t(N));
+        }
+
+        // Overlap-save: the first m - 1 outputs are circularly aliased
+        const auto nout = std::min(L, res.size() - std::size_t(j) * L);
+        std::copy_n(block.cbegin() + signed_size_t(m - 1),
+                    nout,
+                    res.begin() + signed_size_t(std::size_t(j) * L));
+    };
+
+    global_thread_pool().parallel_for(
+        nblocks, convolve_block, std::max(nthreads, std::size_t(1)), 1);
+}
+
+} // namespace detail
+
+template <ConvMode mode = FULL, typename T>
+auto oaconvolve(const std::vector<T> &a,
+                const std::vector<T> &v,
+                std::size_t nthreads = 1) {
+    scicpp_require(!a.empty() && !v.empty());
+
+    const auto &x = v.size() <= a.size() ? a : v;
+    const auto &h = v.size() <= a.size() ? v : a;
+
+    // A single block is larger than the whole convolution
+    if (detail::oa_fft_size(h.size()) >= a.size() + v.size() - 1) {
+        return fftconvolve<mode>(a, v);
+    }
+
+    std::vector<T> res(detail::conv_output_size<mode>(a.size(), v.size()));
+    const auto start = detail::conv_output_start<mode>(a.size(), v.size());
+    detail::oaconvolve_range(res, x, h, start, nthreads);
+    return res;
+}
+
+//---------------------------------------------------------------------------------
+// choose_conv_method
+//
+// The cost of each method is the number of its elementary operations times
+// a per-operation time:
+// - DIRECT: multiply-accumulates, including the zero-padded edges,
+// - FFT: N log2(N) for each of the 3 FFTs of size N = next_fast_len(n + m - 1),
+// - OA: N log2(N) for each of the block FFTs plus the kernel FFT.
+//
+// The per-operation times, in nanoseconds, depend on the machine and can be
+// overridden by defining SCICPP_CONV_COSTS_<FLOAT|DOUBLE|CFLOAT|CDOUBLE>
+// as {direct, fft, oa} before including scicpp. The values for the current
+// machine are printed by `make conv_calibration`.
+//---------------------------------------------------------------------------------
+
+#ifndef SCICPP_CONV_COSTS_FLOAT
+#define SCICPP_CONV_COSTS_FLOAT                                                \
+    { 0.05, 1.0, 0.6 }
+#endif
+
+#ifndef SCICPP_CONV_COSTS_DOUBLE
+#define SCICPP_CONV_COSTS_DOUBLE                                               \
+    { 0.065, 0.95, 0.65 }
+#endif
+
+#ifndef SCICPP_CONV_COSTS_CFLOAT
+#define SCICPP_CONV_COSTS_CFLOAT                                               \
+    { 0.12, 1.5, 1.0 }
+#endif
+
+#ifndef SCICPP_CONV_COSTS_CDOUBLE
+#define SCICPP_CONV_COSTS_CDOUBLE                                              \
+    { 0.22, 2.3, 1.3 }
+#endif
+
+namespace detail {
+
+struct ConvCosts {
+    double direct; // Per multiply-accumulate
+    double fft;    // Per N log2(N) of fftconvolve
+    double oa;     // Per N log2(N) of oaconvolve
+};
+
+template <typename T>
+constexpr ConvCosts conv_costs() {
+    if constexpr (std::is_same_v<T, float>) {
+        return SCICPP_CONV_COSTS_FLOAT;
+    } else if constexpr (std::is_same_v<T, std::complex<float>>) {
+        return SCICPP_CONV_COSTS_CFLOAT;
+    } else if constexpr (meta::is_complex_v<T>) {
+        return SCICPP_CONV_COSTS_CDOUBLE;
+    } else {
+        return SCICPP_CONV_COSTS_DOUBLE;
+    }
+}
+
+// Number of multiply-accumulates of the direct convolution
+// (the edges are computed on zero-padded inputs)
+template <ConvMode mode>
+constexpr double conv_direct_ops(std::size_t n, std::size_t m) {
+    return double(conv_output_size<mode>(n, m)) * double(std::min(n, m));
+}
+
+inline double nlog2n(std::size_t N) { return double(N) * std::log2(double(N)); }
+
+inline double conv_fft_ops(std::size_t n, std::size_t m) {
+    return 3.0 * nlog2n(next_fast_len(n + m - 1));
+}
+
+// Zero if oaconvolve falls back to fftconvolve
+template <ConvMode mode>
+double conv_oa_ops(std::size_t n, std::size_t m) {
+    const auto N = oa_fft_size(std::min(n, m));
+
+    if (N >= n + m - 1) {
+        return 0.0;
+    }
+
+    const auto L = N - std::min(n, m) + 1;
+    const auto nblocks = (conv_output_size<mode>(n, m) + L - 1) / L;
+    return double(2 * nblocks + 1) * nlog2n(N);
+}
+
+} // namespace detail
+
+template <ConvMode mode = FULL, class U, class V>
+constexpr ConvMethod choose_conv_method(const U &a, const V &v) {
+    using T = typename U::value_type;
+
+    if constexpr (!meta::is_std_vector_v<U> || !meta::is_std_vector_v<V> ||
+                  !std::is_floating_point_v<meta::value_type_t<T>>) {
+        // FFT methods are only implemented for floating point std::vector
+        return DIRECT;
+    } else {
+        constexpr auto costs = detail::conv_costs<T>();
+        const auto n = a.size();
+        const auto m = v.size();
+
+        if (n == 0 || m == 0) {
+            return DIRECT;
+        }
+
+        const auto direct_cost =
+            costs.direct * detail::conv_direct_ops<mode>(n, m);
+        const auto fft_cost = costs.fft * detail::conv_fft_ops(n, m);
+        const auto oa_ops = detail::conv_oa_ops<mode>(n, m);
+        const auto oa_cost = oa_ops > 0.0 ? costs.oa * oa_ops : fft_cost;
+
+        if (direct_cost <= std::min(fft_cost, oa_cost)) {
+            return DIRECT;
+        }
+
+        return oa_cost < fft_cost ? OA : FFT;
     }
 }
 
@@ -110,44 +647,194 @@ auto fftconvolve(const std::vector<T> &a, const std::vector<T> &v) {
 // convolve
 //---------------------------------------------------------------------------------
 
-template <ConvMethod method, class U, class V>
+template <ConvMethod method, ConvMode mode = FULL, class U, class V>
 constexpr auto convolve(const U &a, const V &v) {
     static_assert(
         std::is_same_v<typename U::value_type, typename V::value_type>);
 
     if constexpr (method == DIRECT) {
-        return detail::direct_convolve(a, v);
-    } else {
-        return fftconvolve(a, v);
+        return detail::direct_convolve<mode>(a, v);
+    } else if constexpr (method == FFT) {
+        return fftconvolve<mode>(a, v);
+    } else if constexpr (method == OA) {
+        return oaconvolve<mode>(a, v);
+    } else { // method == AUTO
+        if constexpr (meta::is_std_vector_v<U> && meta::is_std_vector_v<V>) {
+            switch (choose_conv_method<mode>(a, v)) {
+            case FFT:
+                return fftconvolve<mode>(a, v);
+            case OA:
+                return oaconvolve<mode>(a, v);
+            default:
+                return detail::direct_convolve<mode>(a, v);
+            }
+        } else {
+            return detail::direct_convolve<mode>(a, v);
+        }
     }
 }
 
 template <class U, class V>
 constexpr auto convolve(const U &a, const V &v) {
-    return convolve<DIRECT>(a, v);
+    return convolve<AUTO>(a, v);
 }
 
 //---------------------------------------------------------------------------------
 // correlate
 //---------------------------------------------------------------------------------
 
-template <ConvMethod method, class U, class V>
+template <ConvMethod method, ConvMode mode = FULL, class U, class V>
 constexpr auto correlate(const U &a, const V &v) {
     auto v_rev = utils::set_array(v);
     std::reverse_copy(v.cbegin(), v.cend(), v_rev.begin());
 
     if constexpr (meta::is_complex_v<typename U::value_type>) {
-        return convolve<method>(a, conj(std::move(v_rev)));
+        return convolve<method, mode>(a, conj(std::move(v_rev)));
     } else {
-        return convolve<method>(a, v_rev);
+        return convolve<method, mode>(a, v_rev);
     }
 }
 
 template <class U, class V>
 constexpr auto correlate(const U &a, const V &v) {
-    return correlate<DIRECT>(a, v);
+    return correlate<AUTO>(a, v);
 }
 
+//---------------------------------------------------------------------------------
+// Correlator
+//
+// Correlation of input blocks with a fixed bank of templates
+// (matched filtering).
+//
+// The spectra of the reversed and conjugated templates are computed once,
+// at an FFT size large enough for the full correlation of the largest input.
+// Each input block is then transformed once, and the correlation with each
+// template is the inverse transform of the product of the spectra.
+// The templates are processed in parallel.
+//---------------------------------------------------------------------------------
+
+template <typename T, ConvMode mode = FULL>
+class Correlator {
+  public:
+    using value_type = T;
+
+    // templates: Templates (can have different sizes).
+    // max_input_size: Size of the largest input to correlate.
+    Correlator(const std::vector<std::vector<T>> &templates,
+               std::size_t max_input_size,
+               std::size_t nthreads = 1)
+        : m_max_input_size(max_input_size),
+          m_nthreads(std::max(nthreads, std::size_t(1))) {
+        scicpp_require(!templates.empty());
+        scicpp_require(max_input_size > 0);
+
+        std::size_t max_template_size = 0;
+
+        for (const auto &v : templates) {
+            scicpp_require(!v.empty());
+            max_template_size = std::max(max_template_size, v.size());
+            m_template_sizes.push_back(v.size());
+        }
+
+        m_fft_size = choose_fft_size(max_input_size + max_template_size - 1);
+
+        for (const auto &v : templates) {
+            std::vector<T> v_rev(m_fft_size, T{0});
+            std::reverse_copy(v.cbegin(), v.cend(), v_rev.begin());
+
+            if constexpr (meta::is_complex_v<T>) {
+                std::transform(v_rev.cbegin(),
+                               v_rev.cend(),
+                               v_rev.begin(),
+                               [](auto z) { return std::conj(z); });
+                m_spectra.push_back(fft(v_rev));
+            } else {
+                m_spectra.push_back(rfft(v_rev));
+            }
+        }
+    }
+
+    // Correlation of x with each template, stored in res
+    // (the buffers of res are reused).
+    void correlate(const std::vector<T> &x, std::vector<std::vector<T>> &res) {
+        scicpp_require(!x.empty() && x.size() <= m_max_input_size);
+        res.resize(m_spectra.size());
+
+        // Input spectrum, computed once for all the templates
+        m_block.assign(m_fft_size, T{0});
+        std::copy(x.cbegin(), x.cend(), m_block.begin());
+        m_spectrum.resize(m_spectra.front().size());
+        engine().fwd(
+            m_spectrum.data(), m_block.data(), signed_size_t(m_fft_size));
+
+        const auto correlate_template = [&](signed_size_t k) {
+            const auto &H = m_spectra[std::size_t(k)];
+            const auto m = m_template_sizes[std::size_t(k)];
+
+            thread_local std::vector<T> block;
+            thread_local std::vector<std::complex<R>> spectrum;
+            block.resize(m_fft_size);
+            spectrum.resize(H.size());
+
+            for (std::size_t i = 0; i < H.size(); ++i) {
+                spectrum[i] = m_spectrum[i] * H[i];
+            }
+
+            engine().inv(
+                block.data(), spectrum.data(), signed_size_t(m_fft_size));
+
+            const auto start = detail::conv_output_start<mode>(x.size(), m);
+            auto &y = res[std::size_t(k)];
+            y.resize(detail::conv_output_size<mode>(x.size(), m));
+            std::copy_n(block.cbegin() + signed_size_t(start),
+                        y.size(),
+                        y.begin());
+        };
+
+        global_thread_pool().parallel_for(signed_size_t(m_spectra.size()),
+                                          correlate_template,
+                                          m_nthreads,
+                                          1);
+    }
+
+    auto correlate(const std::vector<T> &x) {
+        std::vector<std::vector<T>> res;
+        correlate(x, res);
+        return res;
+    }
+
+    auto num_templates() const { return m_spectra.size(); }
+    auto max_input_size() const { return m_max_input_size; }
+    auto fft_size() const { return m_fft_size; }
+
+  private:
+    using R = meta::value_type_t<T>;
+
+    std::size_t m_max_input_size;
+    std::size_t m_nthreads;
+    std::size_t m_fft_size;
+    std::vector<std::size_t> m_template_sizes;
+    std::vector<std::vector<std::complex<R>>> m_spectra;
+    std::vector<T> m_block;
+    std::vector<std::complex<R>> m_spectrum;
+
+    static auto &engine() {
+        return detail::fft_engine<R, !meta::is_complex_v<T>>();
+    }
+
+    // Only multiples of 4 are used for real inputs, since the real FFT
+    // of kissfft falls back to a full complex FFT for other sizes.
+    static std::size_t choose_fft_size(std::size_t n) {
+        auto N = next_fast_len(n);
+
+        while (!meta::is_complex_v<T> && N % 4 != 0) {
+            N = next_fast_len(N + 1);
+        }
+
+        return N;
+    }
+}; // class Correlator
+
 } // namespace scicpp::signal
 
 #endif // SCICPP_SIGNAL_CONVOLVE
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "scicpp/core/equal.hpp"
 #include "scicpp/core/numeric.hpp"
 #include "scicpp/core/print.hpp"
+#include "scicpp/core/random.hpp"
 
 namespace scicpp {
 namespace signal {
@@ -22,6 +23,15 @@ static_assert(float_equal(res[2], 2.5));
 static_assert(float_equal(res[3], 4.));
 static_assert(float_equal(res[4], 1.5));
 
+constexpr auto res_same = convolve<DIRECT, SAME>(a, v);
+static_assert(res_same.size() == 3);
+static_assert(float_equal(res_same[0], 1.));
+static_assert(float_equal(res_same[2], 4.));
+
+constexpr auto res_valid = convolve<DIRECT, VALID>(a, v);
+static_assert(res_valid.size() == 1);
+static_assert(float_equal(res_valid[0], 2.5));
+
 } // namespace convolve_static_tests
 
 //---------------------------------------------------------------------------------
@@ -82,6 +92,114 @@ TEST_CASE("Convolve std::vectors") {
     }
 }
 
+TEST_CASE("Convolve modes") {
+    const std::vector a{3.14, 2.7, 42., 78.5};
+    const std::vector v{1.0, 0.5, 1.0};
+
+    SECTION("std::array") {
+        const std::array aa{3.14, 2.7, 42., 78.5};
+        const std::array va{1.0, 0.5, 1.0};
+        REQUIRE(almost_equal<2>(convolve<DIRECT, SAME>(aa, va),
+                                {4.27, 46.49, 102.2, 81.25}));
+        REQUIRE(almost_equal<2>(convolve<DIRECT, SAME>(va, aa),
+                                {4.27, 46.49, 102.2}));
+        REQUIRE(almost_equal<2>(convolve<DIRECT, VALID>(aa, va),
+                                {46.49, 102.2}));
+        REQUIRE(almost_equal<2>(convolve<DIRECT, VALID>(va, aa),
+                                {46.49, 102.2}));
+    }
+
+    SECTION("Same") {
+        REQUIRE(almost_equal<2>(convolve<DIRECT, SAME>(a, v),
+                                {4.27, 46.49, 102.2, 81.25}));
+        REQUIRE(almost_equal<2>(convolve<DIRECT, SAME>(v, a),
+                                {4.27, 46.49, 102.2}));
+        REQUIRE(almost_equal<50>(convolve<FFT, SAME>(a, v),
+                                 {4.27, 46.49, 102.2, 81.25}));
+        REQUIRE(almost_equal<50>(convolve<FFT, SAME>(v, a),
+                                 {4.27, 46.49, 102.2}));
+    }
+
+    SECTION("Valid") {
+        REQUIRE(almost_equal<2>(convolve<DIRECT, VALID>(a, v), {46.49, 102.2}));
+        REQUIRE(almost_equal<2>(convolve<DIRECT, VALID>(v, a), {46.49, 102.2}));
+        REQUIRE(almost_equal<30>(convolve<FFT, VALID>(a, v), {46.49, 102.2}));
+        REQUIRE(almost_equal<30>(convolve<FFT, VALID>(v, a), {46.49, 102.2}));
+    }
+}
+
+TEST_CASE("Convolve long signals") {
+    // Reference for the direct method: scalar loop on the full convolution
+    const auto naive_convolve = [](const auto &a, const auto &v) {
+        using T = typename std::decay_t<decltype(a)>::value_type;
+        std::vector<T> res(a.size() + v.size() - 1, T{0});
+
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            for (std::size_t j = 0; j < v.size(); ++j) {
+                res[i + j] += a[i] * v[j];
+            }
+        }
+
+        return res;
+    };
+
+    SECTION("double") {
+        const auto a = random::randn<double>(5000);
+
+        for (std::size_t m : {1U, 7U, 32U, 129U, 512U, 1500U}) {
+            const auto v = random::randn<double>(m);
+            const auto ref = naive_convolve(a, v);
+            const auto res = convolve<DIRECT>(a, v);
+            REQUIRE(res.size() == ref.size());
+
+            for (std::size_t i = 0; i < res.size(); ++i) {
+                REQUIRE(std::abs(res[i] - ref[i]) < 1E-11);
+            }
+
+            const auto res_same = convolve<DIRECT, SAME>(a, v);
+            REQUIRE(res_same.size() == a.size());
+            REQUIRE(array_equal(
+                res_same,
+                std::vector(res.cbegin() + signed_size_t((m - 1) / 2),
+                            res.cbegin() + signed_size_t((m - 1) / 2 + 5000))));
+
+            const auto res_valid = convolve<DIRECT, VALID>(v, a);
+            REQUIRE(res_valid.size() == 5000 - m + 1);
+            REQUIRE(array_equal(
+                res_valid,
+                std::vector(res.cbegin() + signed_size_t(m - 1),
+                            res.cbegin() + signed_size_t(5000))));
+        }
+    }
+
+    SECTION("float") {
+        const auto a = random::randn<float>(3000);
+        const auto v = random::randn<float>(100);
+        const auto ref = naive_convolve(a, v);
+        const auto res = convolve<DIRECT>(a, v);
+        REQUIRE(res.size() == ref.size());
+
+        for (std::size_t i = 0; i < res.size(); ++i) {
+            REQUIRE(std::abs(res[i] - ref[i]) < 1E-3f);
+        }
+    }
+
+    SECTION("complex") {
+        using namespace operators;
+        const auto a =
+            random::randn<double>(3000) + 1.0i * random::randn<double>(3000);
+        const auto v =
+            random::randn<double>(100) + 1.0i * random::randn<double>(100);
+        const auto ref = naive_convolve(a, v);
+        const auto res = convolve<DIRECT>(a, v);
+        REQUIRE(res.size() == ref.size());
+
+        for (std::size_t i = 0; i < res.size(); ++i) {
+            REQUIRE(std::abs(res[i] - ref[i]) < 1E-11);
+        }
+    }
+}
+
 //---------------------------------------------------------------------------------
 // fftconvolve
 //---------------------------------------------------------------------------------
@@ -99,7 +217,7 @@ TEST_CASE("fftconvolve") {
         const std::vector a{3.14, 2.7, 42., 78.5};
         const std::vector v{1., 0.5, 1.};
         const auto res = fftconvolve(a, v);
-        REQUIRE(almost_equal<30>(res, {3.14, 4.27, 46.49, 102.2, 81.25, 78.5}));
+        REQUIRE(almost_equal<50>(res, {3.14, 4.27, 46.49, 102.2, 81.25, 78.5}));
     }
 
     SECTION("v smaller than a") {
@@ -126,6 +244,127 @@ TEST_CASE("fftconvolve") {
     }
 }
 
+//---------------------------------------------------------------------------------
+// oaconvolve
+//---------------------------------------------------------------------------------
+
+TEST_CASE("oaconvolve") {
+    const auto max_abs_diff = [](const auto &x, const auto &y) {
+        REQUIRE(x.size() == y.size());
+        double res = 0.0;
+
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            res = std::max(res, double(std::abs(x[i] - y[i])));
+        }
+
+        return res;
+    };
+
+    SECTION("Short signal") {
+        const std::vector a{3.14, 2.7, 42., 78.5};
+        const std::vector v{1., 0.5, 1.};
+        REQUIRE(almost_equal<50>(oaconvolve(a, v),
+                                 {3.14, 4.27, 46.49, 102.2, 81.25, 78.5}));
+        REQUIRE(almost_equal<50>(convolve<OA, SAME>(v, a),
+                                 {4.27, 46.49, 102.2}));
+    }
+
+    SECTION("Long signal") {
+        const auto a = random::randn<double>(20000);
+
+        for (std::size_t m : {1U, 10U, 100U, 1000U}) {
+            const auto v = random::randn<double>(m);
+            REQUIRE(max_abs_diff(oaconvolve(a, v), convolve(a, v)) < 1E-10);
+            REQUIRE(max_abs_diff(oaconvolve(v, a), convolve(a, v)) < 1E-10);
+            REQUIRE(max_abs_diff(convolve<OA, SAME>(a, v),
+                                 convolve<DIRECT, SAME>(a, v)) < 1E-10);
+            REQUIRE(max_abs_diff(convolve<OA, SAME>(v, a),
+                                 convolve<DIRECT, SAME>(v, a)) < 1E-10);
+            REQUIRE(max_abs_diff(convolve<OA, VALID>(a, v),
+                                 convolve<DIRECT, VALID>(a, v)) < 1E-10);
+        }
+    }
+
+    SECTION("Complex") {
+        using namespace operators;
+        const auto a =
+            random::randn<double>(5000) + 1.0i * random::randn<double>(5000);
+        const auto v =
+            random::randn<double>(50) + 1.0i * random::randn<double>(50);
+        REQUIRE(max_abs_diff(oaconvolve(a, v), convolve(a, v)) < 1E-10);
+        REQUIRE(max_abs_diff(correlate<OA>(a, v), correlate(a, v)) < 1E-10);
+    }
+
+    SECTION("Number of threads") {
+        const auto a = random::randn<double>(20000);
+        const auto v = random::randn<double>(64);
+        const auto res = oaconvolve(a, v);
+
+        for (std::size_t nthreads : {2U, 3U, 8U}) {
+            REQUIRE(array_equal(oaconvolve(a, v, nthreads), res));
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+// choose_conv_method
+//---------------------------------------------------------------------------------
+
+TEST_CASE("choose_conv_method") {
+    SECTION("Direct only") {
+        static_assert(choose_conv_method(std::array{1., 2., 3.},
+                                         std::array{1., 2.}) == DIRECT);
+        REQUIRE(choose_conv_method(std::vector<int>(100000, 1),
+                                   std::vector<int>(10000, 1)) == DIRECT);
+        REQUIRE(convolve(std::vector<int>(1000, 1), std::vector<int>(100, 1))
+                    .size() == 1099);
+    }
+
+    SECTION("Sizes") {
+        REQUIRE(choose_conv_method(std::vector<double>(100),
+                                   std::vector<double>(10)) == DIRECT);
+        REQUIRE(choose_conv_method(std::vector<double>(1000000),
+                                   std::vector<double>(4)) == DIRECT);
+        REQUIRE(choose_conv_method(std::vector<double>(1000000),
+                                   std::vector<double>(10000)) == OA);
+        REQUIRE(choose_conv_method(std::vector<double>(10000),
+                                   std::vector<double>(1000000)) == OA);
+        REQUIRE(choose_conv_method(std::vector<double>(100000),
+                                   std::vector<double>(100000)) == FFT);
+        REQUIRE(choose_conv_method<VALID>(std::vector<float>(1000),
+                                          std::vector<float>(999)) ==
+                DIRECT);
+        REQUIRE(choose_conv_method(std::vector<std::complex<float>>(100000),
+                                   std::vector<std::complex<float>>(
+                                       100000)) == FFT);
+    }
+
+    SECTION("AUTO") {
+        const auto max_abs_diff = [](const auto &x, const auto &y) {
+            REQUIRE(x.size() == y.size());
+            double res = 0.0;
+
+            for (std::size_t i = 0; i < x.size(); ++i) {
+                res = std::max(res, double(std::abs(x[i] - y[i])));
+            }
+
+            return res;
+        };
+
+        const auto a = random::randn<double>(20000);
+
+        for (std::size_t m : {5U, 500U, 20000U}) {
+            const auto v = random::randn<double>(m);
+            REQUIRE(max_abs_diff(convolve<AUTO>(a, v),
+                                 convolve<DIRECT>(a, v)) < 1E-9);
+            REQUIRE(max_abs_diff(convolve<AUTO, SAME>(v, a),
+                                 convolve<DIRECT, SAME>(v, a)) < 1E-9);
+            REQUIRE(max_abs_diff(correlate<AUTO, VALID>(a, v),
+                                 correlate<DIRECT, VALID>(a, v)) < 1E-9);
+        }
+    }
+}
+
 //---------------------------------------------------------------------------------
 // correlate
 //---------------------------------------------------------------------------------
@@ -182,6 +421,111 @@ TEST_CASE("correlate") {
                                  81.4 + 0.i,
                                  78.8i}));
     }
+
+    SECTION("Modes") {
+        const std::vector a{3.14, 2.7, 42., 78.5};
+        const std::vector v{1., 0.5, 1.};
+        REQUIRE(almost_equal<2>(correlate<DIRECT, SAME>(a, v),
+                                {4.27, 46.49, 102.2, 81.25}));
+        REQUIRE(
+            almost_equal<2>(correlate<DIRECT, SAME>(v, a), {81.25, 102.2, 46.49}));
+        REQUIRE(
+            almost_equal<2>(correlate<DIRECT, VALID>(v, a), {102.2, 46.49}));
+
+        const std::vector ac{3.14 + 1.i, 2.7 + 3.14i, 42. + 0.i, 78.8i};
+        const std::vector vc{1. + 0.i, 0.5i, 1. + 0.i};
+        REQUIRE(almost_equal<4>(correlate<DIRECT, VALID>(ac, vc),
+                                {46.71 - 0.35i, 2.7 + 60.94i}));
+        REQUIRE(almost_equal<4>(correlate<DIRECT, VALID>(vc, ac),
+                                {2.7 - 60.94i, 46.71 + 0.35i}));
+    }
+}
+
+//---------------------------------------------------------------------------------
+// Correlator
+//---------------------------------------------------------------------------------
+
+TEST_CASE("Correlator") {
+    const auto max_abs_diff = [](const auto &x, const auto &y) {
+        REQUIRE(x.size() == y.size());
+        double res = 0.0;
+
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            res = std::max(res, double(std::abs(x[i] - y[i])));
+        }
+
+        return res;
+    };
+
+    SECTION("Short signal") {
+        const std::vector a{3.14, 2.7, 42., 78.8};
+        Correlator<double> correlator({{1., 0.5, 1.}, {1., 2.}}, 4);
+        REQUIRE(correlator.num_templates() == 2);
+        REQUIRE(correlator.fft_size() % 4 == 0);
+        const auto res = correlator.correlate(a);
+        REQUIRE(res.size() == 2);
+        REQUIRE(almost_equal<50>(res[0],
+                                 {3.14, 4.27, 46.49, 102.5, 81.4, 78.8}));
+        REQUIRE(almost_equal<50>(res[1], {6.28, 8.54, 86.7, 199.6, 78.8}));
+    }
+
+    SECTION("Real templates") {
+        const auto templates = std::vector{random::randn<double>(64),
+                                           random::randn<double>(100),
+                                           random::randn<double>(17)};
+        Correlator<double> correlator(templates, 1000);
+        Correlator<double, SAME> correlator_same(templates, 1000);
+        Correlator<double, VALID> correlator_valid(templates, 1000);
+        std::vector<std::vector<double>> res;
+
+        for (std::size_t n : {1000U, 700U, 10U}) {
+            const auto a = random::randn<double>(n);
+            correlator.correlate(a, res);
+            REQUIRE(res.size() == templates.size());
+
+            for (std::size_t k = 0; k < templates.size(); ++k) {
+                const auto &v = templates[k];
+                REQUIRE(max_abs_diff(res[k], correlate<DIRECT>(a, v)) <
+                        1E-10);
+                REQUIRE(max_abs_diff(correlator_same.correlate(a)[k],
+                                     correlate<DIRECT, SAME>(a, v)) < 1E-10);
+                REQUIRE(max_abs_diff(correlator_valid.correlate(a)[k],
+                                     correlate<DIRECT, VALID>(a, v)) < 1E-10);
+            }
+        }
+    }
+
+    SECTION("Complex templates") {
+        using namespace operators;
+        const auto a =
+            random::randn<double>(500) + 1.0i * random::randn<double>(500);
+        const auto templates = std::vector{
+            random::randn<double>(50) + 1.0i * random::randn<double>(50),
+            random::randn<double>(31) + 1.0i * random::randn<double>(31)};
+        Correlator<std::complex<double>> correlator(templates, a.size());
+        const auto res = correlator.correlate(a);
+
+        for (std::size_t k = 0; k < templates.size(); ++k) {
+            REQUIRE(max_abs_diff(res[k], correlate<DIRECT>(a, templates[k])) <
+                    1E-10);
+        }
+    }
+
+    SECTION("Number of threads") {
+        std::vector<std::vector<float>> templates;
+
+        for (std::size_t k = 0; k < 16; ++k) {
+            templates.push_back(random::randn<float>(128));
+        }
+
+        const auto a = random::randn<float>(4096);
+        const auto res = Correlator<float>(templates, a.size()).correlate(a);
+
+        for (std::size_t nthreads : {2U, 3U, 8U}) {
+            Correlator<float> correlator(templates, a.size(), nthreads);
+            REQUIRE(correlator.correlate(a) == res);
+        }
+    }
 }
 
 } // namespace signal
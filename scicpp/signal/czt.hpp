@@ -0,0 +1,343 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#ifndef SCICPP_SIGNAL_CZT
+#define SCICPP_SIGNAL_CZT
+
+#include "scicpp/core/macros.hpp"
+#include "scicpp/core/meta.hpp"
+#include "scicpp/signal/fft.hpp"
+#include "scicpp/signal/mixed_radix_fft.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace scicpp::signal {
+
+//---------------------------------------------------------------------------------
+// Chirp Z-transform
+//
+// Z-transform of x on the m points z_k = a w^-k, k < m, of a spiral:
+// X[k] = sum_{j < n} x[j] z_k^-j.
+//
+// Computed with Bluestein's algorithm (see detail::ChirpZ), as a convolution
+// with a chirp by FFTs of size ~ n + m. The cost scales with the number of
+// output points, whatever the frequency resolution.
+// Off the unit circle, the chirps scale as |w|^(k^2 / 2): the accuracy
+// degrades quickly with n + m unless |w| is close to 1.
+//
+// The CZT and ZoomFFT classes compute the chirps and the spectrum of the
+// convolution kernel once, for repeated transforms of the same size.
+// The czt and zoom_fft functions cache them per thread.
+//---------------------------------------------------------------------------------
+
+namespace detail {
+
+constexpr auto czt_pi = 3.141592653589793238462643383279502884L;
+
+// exp(i phi k^2 / 2)
+inline auto quadratic_phase(long double phi) {
+    return [phi](std::size_t k) {
+        const auto kl = static_cast<long double>(k);
+        return std::polar(1.0L, phi * kl * kl / 2);
+    };
+}
+
+// exp(i phi k)
+inline auto linear_phase(long double phi) {
+    return [phi](std::size_t k) {
+        return std::polar(1.0L, phi * static_cast<long double>(k));
+    };
+}
+
+// w^(k^2 / 2) with w = exp(-2 i pi / m), k^2 being reduced modulo 2 m
+inline auto dft_chirp(std::size_t m) {
+    return [m](std::size_t k) {
+        const auto k2 = (k * k) % (2 * m);
+        return std::polar(1.0L,
+                          -czt_pi * static_cast<long double>(k2) /
+                              static_cast<long double>(m));
+    };
+}
+
+inline std::size_t czt_output_size(std::size_t n, int m) {
+    return m < 0 ? n : std::size_t(m);
+}
+
+} // namespace detail
+
+// Points of the chirp Z-transform, z_k = a w^-k for k < m
+template <typename T>
+auto czt_points(int m, std::complex<T> w, std::complex<T> a = T{1}) {
+    scicpp_require(m > 0);
+
+    using Cplx = std::complex<long double>;
+    const auto log_w = std::log(Cplx(w));
+    std::vector<std::complex<T>> z(static_cast<std::size_t>(m), a);
+
+    for (std::size_t k = 1; k < z.size(); ++k) {
+        z[k] = std::complex<T>(
+            Cplx(a) * std::exp(-static_cast<long double>(k) * log_w));
+    }
+
+    return z;
+}
+
+// Roots of unity exp(2 i pi k / m) (w = exp(-2 i pi / m) and a = 1)
+template <typename T = double>
+auto czt_points(int m) {
+    scicpp_require(m > 0);
+
+    std::vector<std::complex<T>> z(static_cast<std::size_t>(m));
+
+    for (std::size_t k = 0; k < z.size(); ++k) {
+        z[k] = std::complex<T>(std::polar(
+            1.0L,
+            2 * detail::czt_pi * static_cast<long double>(k) /
+                static_cast<long double>(m)));
+    }
+
+    return z;
+}
+
+template <typename T = double>
+class CZT {
+  public:
+    using value_type = std::complex<T>;
+
+    // Transform of inputs of size n on the m points z_k = a w^-k
+    CZT(std::size_t n, int m, std::complex<T> w, std::complex<T> a = T{1})
+        : CZT(n,
+              detail::czt_output_size(n, m),
+              w,
+              a,
+              detail::quadratic_phase(std::arg(w)),
+              detail::linear_phase(-std::arg(a)),
+              std::abs(w),
+              std::abs(a)) {}
+
+    // Transform on the m roots of unity exp(2 i pi k / m)
+    // (the DFT for m = n, the default)
+    explicit CZT(std::size_t n, int m = -1)
+        : CZT(n,
+              detail::czt_output_size(n, m),
+              std::polar(T{1},
+                         T(-2 * detail::czt_pi /
+                           static_cast<long double>(
+                               detail::czt_output_size(n, m)))),
+              T{1},
+              detail::dft_chirp(detail::czt_output_size(n, m)),
+              detail::linear_phase(0)) {}
+
+    // Chirp Z-transform of x (of size n), stored into dst
+    template <class Array>
+    void operator()(const Array &x, std::vector<value_type> &dst) {
+        scicpp_require(std::size_t(x.size()) == m_plan.input_size());
+
+        m_input.resize(m_plan.input_size());
+        std::copy(x.cbegin(), x.cend(), m_input.begin());
+        dst.resize(m_plan.output_size());
+        m_plan.transform(
+            detail::fft_engine<T>(), dst.data(), m_input.data(), m_work);
+    }
+
+    template <class Array>
+    auto operator()(const Array &x) {
+        std::vector<value_type> dst;
+        (*this)(x, dst);
+        return dst;
+    }
+
+    // Points z_k at which the Z-transform is computed
+    auto points() const {
+        return czt_points(int(m_plan.output_size()), m_w, m_a);
+    }
+
+    std::size_t input_size() const { return m_plan.input_size(); }
+    std::size_t output_size() const { return m_plan.output_size(); }
+    std::size_t fft_size() const { return m_plan.fft_size(); }
+
+  protected:
+    // Transform with the phases of chirp(k) = w^(k^2 / 2) and ramp(k) = a^-k
+    // computed from exact arguments. |w| and |a| scale their moduli.
+    template <class Chirp, class Ramp>
+    CZT(std::size_t n,
+        std::size_t m,
+        std::complex<T> w,
+        std::complex<T> a,
+        Chirp &&chirp,
+        Ramp &&ramp,
+        T abs_w = T{1},
+        T abs_a = T{1})
+        : m_w(w),
+          m_a(a),
+          m_plan(
+              n,
+              m,
+              [&](std::size_t k) {
+                  const auto k2 = static_cast<long double>(k) *
+                                  static_cast<long double>(k);
+                  return std::pow(static_cast<long double>(abs_w), k2 / 2) *
+                         chirp(k);
+              },
+              [&](std::size_t k) {
+                  return std::pow(static_cast<long double>(abs_a),
+                                  -static_cast<long double>(k)) *
+                         ramp(k);
+              },
+              detail::fft_engine<T>()) {}
+
+  private:
+    std::complex<T> m_w;
+    std::complex<T> m_a;
+    detail::ChirpZ<T> m_plan;
+    std::vector<value_type> m_input;
+    std::vector<value_type> m_work;
+}; // class CZT
+
+//---------------------------------------------------------------------------------
+// Zoom FFT
+//
+// DFT of x on m frequencies evenly spaced in the band [f1, f2), or [f1, f2]
+// if endpoint is true, for the sampling frequency fs: f1 + k (f2 - f1) / m
+// (resp. / (m - 1)), k < m.
+//
+// This is a chirp Z-transform along the unit circle,
+// with a = exp(2 i pi f1 / fs) and w = exp(-2 i pi (f2 - f1) / (m fs))
+// (resp. / ((m - 1) fs)).
+//---------------------------------------------------------------------------------
+
+namespace detail {
+
+// Frequency step over fs
+template <typename T>
+scicpp_pure long double
+zoom_fft_step(std::array<T, 2> fn, std::size_t m, T fs, bool endpoint) {
+    scicpp_require(m > 0 && fs > T{0});
+    scicpp_require(!endpoint || m > 1);
+
+    const auto df = static_cast<long double>(fn[1]) -
+                    static_cast<long double>(fn[0]);
+    const auto nsteps = static_cast<long double>(endpoint ? m - 1 : m);
+    return df / (nsteps * static_cast<long double>(fs));
+}
+
+} // namespace detail
+
+template <typename T = double>
+class ZoomFFT : public CZT<T> {
+  public:
+    // Band [fn[0], fn[1]]
+    ZoomFFT(std::size_t n,
+            std::array<T, 2> fn,
+            int m = -1,
+            T fs = T{2},
+            bool endpoint = false)
+        : ZoomFFT(n,
+                  detail::czt_output_size(n, m),
+                  fn[0] / fs,
+                  detail::zoom_fft_step(
+                      fn, detail::czt_output_size(n, m), fs, endpoint)) {}
+
+    // Band [0, fn]
+    ZoomFFT(std::size_t n,
+            T fn,
+            int m = -1,
+            T fs = T{2},
+            bool endpoint = false)
+        : ZoomFFT(n, {T{0}, fn}, m, fs, endpoint) {}
+
+  private:
+    // a = exp(2 i pi f), w = exp(-2 i pi step)
+    ZoomFFT(std::size_t n, std::size_t m, long double f, long double step)
+        : CZT<T>(n,
+                 m,
+                 std::polar(T{1}, T(-2 * detail::czt_pi * step)),
+                 std::polar(T{1}, T(2 * detail::czt_pi * f)),
+                 detail::quadratic_phase(-2 * detail::czt_pi * step),
+                 detail::linear_phase(-2 * detail::czt_pi * f)) {}
+}; // class ZoomFFT
+
+//---------------------------------------------------------------------------------
+// czt, zoom_fft
+//---------------------------------------------------------------------------------
+
+namespace detail {
+
+enum CztKind : int { CZT_DFT, CZT_SPIRAL, CZT_ZOOM };
+
+template <typename T>
+using CztKey = std::tuple<CztKind, std::size_t, int, T, T, T, T>;
+
+// Transform of the calling thread for the key, built by make() if needed
+template <typename T, class Make>
+CZT<T> &cached_czt(const CztKey<T> &key, Make &&make) {
+    thread_local std::map<CztKey<T>, CZT<T>> transforms;
+    auto it = transforms.find(key);
+
+    if (it == transforms.end()) {
+        it = transforms.emplace(key, make()).first;
+    }
+
+    return it->second;
+}
+
+} // namespace detail
+
+// Chirp Z-transform on the m points z_k = a w^-k
+template <class Array, typename T>
+auto czt(const Array &x, int m, std::complex<T> w, std::complex<T> a = T{1}) {
+    const auto n = std::size_t(x.size());
+    const detail::CztKey<T> key{
+        detail::CZT_SPIRAL, n, m, w.real(), w.imag(), a.real(), a.imag()};
+
+    return detail::cached_czt<T>(key, [&]() { return CZT<T>(n, m, w, a); })(x);
+}
+
+// Chirp Z-transform on the m roots of unity (the DFT for m = n, the default)
+template <class Array>
+auto czt(const Array &x, int m = -1) {
+    using T = meta::value_type_t<typename Array::value_type>;
+
+    const auto n = std::size_t(x.size());
+    const detail::CztKey<T> key{detail::CZT_DFT, n, m, T{0}, T{0}, T{0}, T{0}};
+
+    return detail::cached_czt<T>(key, [&]() { return CZT<T>(n, m); })(x);
+}
+
+// DFT of x on m frequencies of the band [fn[0], fn[1]]
+template <class Array,
+          typename T = meta::value_type_t<typename Array::value_type>>
+auto zoom_fft(const Array &x,
+              std::array<T, 2> fn,
+              int m = -1,
+              T fs = T{2},
+              bool endpoint = false) {
+    const auto n = std::size_t(x.size());
+    const detail::CztKey<T> key{
+        detail::CZT_ZOOM, n, m, fn[0], fn[1], fs, T(endpoint)};
+
+    return detail::cached_czt<T>(
+        key, [&]() { return ZoomFFT<T>(n, fn, m, fs, endpoint); })(x);
+}
+
+// DFT of x on m frequencies of the band [0, fn]
+template <class Array,
+          typename T = meta::value_type_t<typename Array::value_type>>
+auto zoom_fft(const Array &x,
+              T fn,
+              int m = -1,
+              T fs = T{2},
+              bool endpoint = false) {
+    return zoom_fft(x, std::array{T{0}, fn}, m, fs, endpoint);
+}
+
+} // namespace scicpp::signal
+
+#endif // SCICPP_SIGNAL_CZT
@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#include "czt.hpp"
+
+#include "scicpp/core/constants.hpp"
+#include "scicpp/core/numeric.hpp"
+#include "scicpp/core/random.hpp"
+
+#include <complex>
+#include <vector>
+
+namespace scicpp::signal {
+
+namespace {
+
+// Largest distance between x and y, relative to the largest magnitude of y
+template <class ArrayX, class ArrayY>
+double czt_error(const ArrayX &x, const ArrayY &y) {
+    REQUIRE(x.size() == y.size());
+    double err = 0.0;
+    double norm = 0.0;
+
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        err = std::max(err, double(std::abs(std::complex<double>(x[i]) -
+                                            std::complex<double>(y[i]))));
+        norm = std::max(norm, double(std::abs(std::complex<double>(y[i]))));
+    }
+
+    return err / norm;
+}
+
+// Direct evaluation of sum_j x[j] z_k^-j
+template <class Array>
+auto z_transform(const Array &x, const std::vector<std::complex<double>> &z) {
+    using Cplx = std::complex<long double>;
+    std::vector<std::complex<double>> res(z.size());
+
+    for (std::size_t k = 0; k < z.size(); ++k) {
+        Cplx acc{0};
+        Cplx zk{1};
+
+        for (std::size_t j = 0; j < x.size(); ++j) {
+            acc += Cplx(x[j]) * zk;
+            zk /= Cplx(z[k]);
+        }
+
+        res[k] = std::complex<double>(acc);
+    }
+
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("czt_points") {
+    using namespace std::complex_literals;
+
+    const auto z = czt_points(3, 0.99 * std::exp(-0.3i), 1.1 * std::exp(0.2i));
+    // scipy.signal.czt_points(3, 0.99 * exp(-0.3j), 1.1 * exp(0.2j))
+    REQUIRE(czt_error(z,
+                      std::vector{1.07807324 + 0.21853626i,
+                                  0.97509174 + 0.53269504i,
+                                  0.78193795 + 0.80511346i}) < 1E-8);
+
+    const auto roots = czt_points(8);
+    REQUIRE(roots.size() == 8);
+    REQUIRE(std::abs(roots[0] - 1.0) < 1E-15);
+    REQUIRE(std::abs(roots[2] - 1i) < 1E-15);
+    REQUIRE(std::abs(roots[4] + 1.0) < 1E-15);
+}
+
+TEST_CASE("czt") {
+    using namespace std::complex_literals;
+
+    SECTION("Spiral contour") {
+        const std::vector x{1., 2., 3., -1., 0.5};
+        const auto w = 0.99 * std::exp(-0.3i);
+        const auto a = 1.1 * std::exp(0.2i);
+        // scipy.signal.czt(x, 3, 0.99 * exp(-0.3j), 1.1 * exp(0.2j))
+        REQUIRE(czt_error(czt(x, 3, w, a),
+                          std::vector{4.6834047 - 1.14747467i,
+                                      3.70449882 - 2.47886164i,
+                                      2.3789963 - 3.16277345i}) < 1E-8);
+
+        const auto x2 = random::rand<double>(40);
+        REQUIRE(czt_error(czt(x2, 20, w, a),
+                          z_transform(x2, czt_points(20, w, a))) < 1E-12);
+    }
+
+    SECTION("Default is the DFT") {
+        for (std::size_t n : {1U, 7U, 64U, 97U, 1000U, 1009U}) {
+            const auto x = random::rand<double>(n);
+            REQUIRE(czt_error(czt(x), fft(x)) < 1E-13);
+        }
+    }
+
+    SECTION("Roots of unity") {
+        const auto x = random::rand<double>(100);
+        REQUIRE(czt_error(czt(x, 37), z_transform(x, czt_points(37))) < 1E-13);
+    }
+
+    SECTION("Complex float input") {
+        std::vector<std::complex<float>> x(257);
+
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            x[i] = {float(i % 7) - 3.0f, float(i % 3)};
+        }
+
+        REQUIRE(czt_error(czt(x), fft(x)) < 1E-5);
+    }
+
+    SECTION("CZT") {
+        const auto w = std::exp(-0.01i);
+        CZT<double> transform(128, 300, w);
+        REQUIRE(transform.input_size() == 128);
+        REQUIRE(transform.output_size() == 300);
+        REQUIRE(transform.fft_size() >= 427);
+
+        std::vector<std::complex<double>> y;
+
+        for (int i = 0; i < 3; ++i) {
+            const auto x = random::rand<double>(128);
+            transform(x, y);
+            REQUIRE(y.size() == 300);
+            REQUIRE(czt_error(y, z_transform(x, transform.points())) < 1E-12);
+        }
+    }
+}
+
+TEST_CASE("zoom_fft") {
+    using namespace std::complex_literals;
+
+    SECTION("Reference values") {
+        const std::vector x{1., 2., 3., -1., 0.5};
+
+        // scipy.signal.zoom_fft(x, [0.1, 0.4], 4, fs=1)
+        REQUIRE(czt_error(zoom_fft(x, {0.1, 0.4}, 4, 1.0),
+                          std::vector{3.44959347 - 3.37157616i,
+                                      0.97780509 - 3.88997024i,
+                                      -1.5 - 3.0i,
+                                      -2.81353359 + 0.01307521i}) < 1E-8);
+
+        // scipy.signal.zoom_fft(x, [0.1, 0.4], 4, fs=1, endpoint=True)
+        REQUIRE(czt_error(zoom_fft(x, {0.1, 0.4}, 4, 1.0, true),
+                          std::vector{3.44959347 - 3.37157616i,
+                                      0.1545085 - 3.77772578i,
+                                      -2.69959347 - 1.20207079i,
+                                      -0.4045085 + 2.92254819i}) < 1E-8);
+
+        // scipy.signal.zoom_fft(x, 0.5)
+        REQUIRE(czt_error(zoom_fft(x, 0.5),
+                          std::vector{5.5 + 0.0i,
+                                      4.89588726 - 2.04790101i,
+                                      3.44959347 - 3.37157616i,
+                                      1.79506754 - 3.86829392i,
+                                      0.1545085 - 3.77772578i}) < 1E-8);
+    }
+
+    SECTION("Narrow band") {
+        // 1000 bins between 99 and 101 Hz
+        const double fs = 1000.0;
+        const auto x = random::rand<double>(4096);
+        ZoomFFT<double> zoom(4096, {99.0, 101.0}, 1000, fs);
+        const auto y = zoom(x);
+
+        std::vector<std::complex<double>> z(1000);
+
+        for (std::size_t k = 0; k < z.size(); ++k) {
+            const auto f = 99.0 + 2.0 * double(k) / 1000.0;
+            z[k] = std::polar(1.0, 2.0 * pi<double> * f / fs);
+        }
+
+        REQUIRE(czt_error(y, z_transform(x, z)) < 1E-11);
+        REQUIRE(czt_error(zoom.points(), z) < 1E-12);
+        REQUIRE(czt_error(zoom_fft(x, {99.0, 101.0}, 1000, fs), y) < 1E-15);
+    }
+
+    SECTION("Full band is the DFT") {
+        const auto x = random::rand<double>(360);
+        REQUIRE(czt_error(zoom_fft(x, 2.0), fft(x)) < 1E-13);
+        REQUIRE(czt_error(zoom_fft(x, 360.0, -1, 360.0), fft(x)) < 1E-13);
+    }
+}
+
+} // namespace scicpp::signal
@@ -2,8 +2,9 @@
 // Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
 
 #include "fft.hpp"
+#include "czt.hpp"
 
-#include "scicpp/random.hpp"
+#include "scicpp/core/random.hpp"
 #include "scicpp/signal/windows.hpp"
 
 //---------------------------------------------------------------------------------
@@ -22,6 +23,111 @@ NONIUS_BENCHMARK("signal::ifft (1000)", [](nonius::chronometer meter) {
     meter.measure([&v]() { return scicpp::signal::ifft(v); });
 })
 
+NONIUS_BENCHMARK("signal::rfft (1024)", [](nonius::chronometer meter) {
+    const auto v = scicpp::random::rand<double>(1024);
+    std::vector<std::complex<double>> y;
+
+    meter.measure([&]() {
+        scicpp::signal::rfft_inplace(v, y);
+        return y.size();
+    });
+})
+
+NONIUS_BENCHMARK("signal::rfft (1024, float)", [](nonius::chronometer meter) {
+    const auto v = scicpp::random::rand<float>(1024);
+    std::vector<std::complex<float>> y;
+
+    meter.measure([&]() {
+        scicpp::signal::rfft_inplace(v, y);
+        return y.size();
+    });
+})
+
+NONIUS_BENCHMARK("signal::rfft (2^22)", [](nonius::chronometer meter) {
+    const auto v = scicpp::random::rand<double>(1 << 22);
+    std::vector<std::complex<double>> y;
+
+    meter.measure([&]() {
+        scicpp::signal::rfft_inplace(v, y);
+        return y.size();
+    });
+})
+
+NONIUS_BENCHMARK("signal::fft (1024, complex)", [](nonius::chronometer meter) {
+    const auto v = scicpp::random::rand<double>(1024);
+    std::vector<std::complex<double>> y, z;
+    scicpp::signal::fft_inplace(v, y);
+
+    meter.measure([&]() {
+        scicpp::signal::fft_inplace(y, z);
+        return z.size();
+    });
+})
+
+NONIUS_BENCHMARK("signal::rfft (64 x 1024, loop)",
+                 [](nonius::chronometer meter) {
+                     std::vector<std::vector<double>> rows;
+
+                     for (std::size_t i = 0; i < 64; ++i) {
+                         rows.push_back(scicpp::random::rand<double>(1024));
+                     }
+
+                     meter.measure([&rows]() {
+                         std::vector<std::vector<std::complex<double>>> res;
+
+                         for (const auto &row : rows) {
+                             res.push_back(scicpp::signal::rfft(row));
+                         }
+
+                         return res;
+                     });
+                 })
+
+NONIUS_BENCHMARK("signal::rfft_batch (64 x 1024)",
+                 [](nonius::chronometer meter) {
+                     const auto x = scicpp::random::rand<double>(64 * 1024);
+                     std::vector<std::complex<double>> y;
+
+                     meter.measure([&]() {
+                         scicpp::signal::rfft_batch(x, 64, y);
+                         return y.size();
+                     });
+                 })
+
+NONIUS_BENCHMARK("signal::rfft_batch (64 x 1024, 4 threads)",
+                 [](nonius::chronometer meter) {
+                     const auto x = scicpp::random::rand<double>(64 * 1024);
+                     std::vector<std::complex<double>> y;
+
+                     meter.measure([&]() {
+                         scicpp::signal::rfft_batch(x, 64, y, 4);
+                         return y.size();
+                     });
+                 })
+
+NONIUS_BENCHMARK("signal::fft (1009, prime)", [](nonius::chronometer meter) {
+    const auto v = scicpp::random::rand<double>(1009);
+
+    meter.measure([&v]() { return scicpp::signal::fft(v); });
+})
+
+//---------------------------------------------------------------------------------
+// Chirp Z-transform
+//---------------------------------------------------------------------------------
+
+NONIUS_BENCHMARK("signal::zoom_fft (65536, 1000 bins)",
+                 [](nonius::chronometer meter) {
+                     const auto v = scicpp::random::rand<double>(65536);
+                     scicpp::signal::ZoomFFT<double> zoom(
+                         v.size(), {99.0, 101.0}, 1000, 1000.0);
+                     std::vector<std::complex<double>> y;
+
+                     meter.measure([&]() {
+                         zoom(v, y);
+                         return y.size();
+                     });
+                 })
+
 //---------------------------------------------------------------------------------
 // Power spectrum
 //---------------------------------------------------------------------------------
@@ -7,12 +7,16 @@
 #include "scicpp/core/macros.hpp"
 #include "scicpp/core/numeric.hpp"
 #include "scicpp/core/range.hpp"
+#include "scicpp/core/thread_pool.hpp"
 #include "scicpp/core/utils.hpp"
+#include "scicpp/signal/mixed_radix_fft.hpp"
 
 #include <algorithm>
 #include <array>
 #include <complex>
 #include <cstdlib>
+#include <iterator>
+#include <type_traits>
 #include <unsupported/Eigen/FFT>
 #include <utility>
 #include <vector>
@@ -184,147 +188,384 @@ auto zero_padding(std::vector<T> &&v, std::size_t new_size) {
 }
 
 //---------------------------------------------------------------------------------
-// FFTs
+// FFT plan cache
+//
+// float and double transforms use the in-tree mixed-radix FFT
+// (mixed_radix_fft.hpp), other precisions use Eigen's kissfft backend.
+// Define SCICPP_FFT_EIGEN to use kissfft for all precisions.
+//
+// Both engines store the factorization and the twiddle factors of each size
+// they have been called with, so they are only computed once as long as the
+// same engine is reused.
+//
+// Engines are not thread-safe, hence one engine per thread, per precision T
+// and per spectrum type (full or half spectrum for real inputs).
 //---------------------------------------------------------------------------------
 
-template <class InputIt, class CplxVector>
-void fft_inplace(InputIt first, InputIt last, CplxVector &dst) {
-    using T = typename CplxVector::value_type::value_type;
-
-    const auto src_size = std::distance(first, last);
-    scicpp_require(src_size != 0);
+namespace detail {
 
-    dst.resize(std::size_t(src_size));
-    Eigen::FFT<T> fft_engine;
-    fft_engine.fwd(dst.data(), &*first, src_size);
+template <typename T, bool half_spectrum = false>
+auto &fft_engine() {
+#ifndef SCICPP_FFT_EIGEN
+    if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+        thread_local MixedRadixFFT<T, half_spectrum> engine;
+        return engine;
+    } else
+#endif
+    {
+        using Engine = Eigen::FFT<T>;
+
+        thread_local Engine engine(
+            typename Engine::impl_type(),
+            half_spectrum ? Engine::HalfSpectrum : Engine::Default);
+
+        return engine;
+    }
 }
 
-template <class Array, class CplxVector>
-void fft_inplace(const Array &x, CplxVector &dst) {
-    fft_inplace(x.cbegin(), x.cend(), dst);
-}
+} // namespace detail
 
-template <class Array, class CplxVector>
-auto fft(const Array &x, CplxVector &&dst) {
-    scicpp_require(!x.empty());
+//---------------------------------------------------------------------------------
+// FFTs
+//
+// The *_inplace functions write the transform into a caller-provided vector,
+// resized if needed. The input is truncated or zero-padded to the transform
+// size n inside the transform, using a per-thread scratch buffer, so that
+// repeated transforms into the same vector do not allocate.
+//---------------------------------------------------------------------------------
 
-    if (x.size() == 1) {
-        dst.resize(1);
-        dst[0] = x[0];
-    } else {
-        fft_inplace(x, dst);
+namespace detail {
+
+// Scratch buffer of the thread, holding at least size values
+template <typename T>
+T *fft_scratch(std::size_t size) {
+    thread_local std::vector<T> buffer;
+
+    if (buffer.size() < size) {
+        buffer.resize(size);
     }
 
-    return std::move(dst);
+    return buffer.data();
 }
 
-template <class Array>
-auto fft(const Array &x) {
-    using Tarr = typename Array::value_type;
+// Input [first, last) converted to T, truncated or zero-padded to size
+template <typename T, class InputIt>
+const T *fft_input(InputIt first, InputIt last, std::size_t size) {
+    using Tin = typename std::iterator_traits<InputIt>::value_type;
+    const auto src_size = std::size_t(std::distance(first, last));
 
-    if constexpr (meta::is_complex_v<Tarr>) {
-        using T = typename Tarr::value_type;
-        std::vector<std::complex<T>> y;
-        return fft(x, std::move(y));
-    } else {
-        std::vector<std::complex<Tarr>> y;
-        return fft(x, std::move(y));
+    if constexpr (std::is_same_v<Tin, T>) {
+        if (src_size >= size) {
+            return &*first;
+        }
     }
+
+    const auto buffer = fft_scratch<T>(size);
+    const auto ncopy = std::min(size, src_size);
+    std::copy_n(first, ncopy, buffer);
+    std::fill(buffer + ncopy, buffer + size, T{0});
+    return buffer;
+}
+
+template <typename InputIt>
+scicpp_pure std::size_t transform_size(InputIt first, InputIt last, int n) {
+    const auto size =
+        n < 0 ? std::size_t(std::distance(first, last)) : std::size_t(n);
+    scicpp_require(size != 0);
+    return size;
 }
 
-template <class InputIt, class CplxVector>
-void rfft_inplace(InputIt first, InputIt last, CplxVector &dst) {
+} // namespace detail
+
+template <class InputIt,
+          class CplxVector,
+          meta::disable_if_iterable<InputIt> = 0>
+void fft_inplace(InputIt first, InputIt last, CplxVector &dst, int n = -1) {
     using T = typename CplxVector::value_type::value_type;
+    using Tin = typename std::iterator_traits<InputIt>::value_type;
 
-    const auto src_size = std::distance(first, last);
-    scicpp_require(src_size != 0);
+    const auto size = detail::transform_size(first, last, n);
+    dst.resize(size);
 
-    dst.resize(std::size_t(src_size) / 2 + 1);
-    Eigen::FFT<T> fft_engine;
-    fft_engine.SetFlag(Eigen::FFT<T>::HalfSpectrum);
-    fft_engine.fwd(dst.data(), &*first, src_size);
+    if (size == 1) {
+        dst[0] = first != last ? *first : Tin{0};
+    } else {
+        const auto src = detail::fft_input<Tin>(first, last, size);
+        detail::fft_engine<T>().fwd(dst.data(), src, signed_size_t(size));
+    }
 }
 
 template <class Array, class CplxVector>
-void rfft_inplace(const Array &x, CplxVector &dst) {
-    rfft_inplace(x.cbegin(), x.cend(), dst);
+void fft_inplace(const Array &x, CplxVector &dst, int n = -1) {
+    fft_inplace(x.cbegin(), x.cend(), dst, n);
 }
 
-template <class Array, class CplxVector>
-auto rfft(const Array &x, CplxVector &&dst) {
+template <class Array,
+          class CplxVector,
+          meta::enable_if_iterable<CplxVector> = 0>
+auto fft(const Array &x, CplxVector &&dst, int n = -1) {
     scicpp_require(!x.empty());
+    fft_inplace(x, dst, n);
+    return std::move(dst);
+}
 
-    if (x.size() == 1) {
-        dst.resize(1);
-        dst[0] = x[0];
+template <class Array>
+auto fft(const Array &x, int n = -1) {
+    using T = meta::value_type_t<typename Array::value_type>;
+    std::vector<std::complex<T>> y;
+    return fft(x, std::move(y), n);
+}
+
+template <class InputIt,
+          class CplxVector,
+          meta::disable_if_iterable<InputIt> = 0>
+void rfft_inplace(InputIt first, InputIt last, CplxVector &dst, int n = -1) {
+    using T = typename CplxVector::value_type::value_type;
+
+    const auto size = detail::transform_size(first, last, n);
+    dst.resize(size / 2 + 1);
+
+    if (size == 1) {
+        dst[0] = first != last ? *first : T{0};
     } else {
-        rfft_inplace(x, dst);
+        const auto src = detail::fft_input<T>(first, last, size);
+        detail::fft_engine<T, true>().fwd(
+            dst.data(), src, signed_size_t(size));
     }
+}
+
+template <class Array, class CplxVector>
+void rfft_inplace(const Array &x, CplxVector &dst, int n = -1) {
+    rfft_inplace(x.cbegin(), x.cend(), dst, n);
+}
 
+template <class Array,
+          class CplxVector,
+          meta::enable_if_iterable<CplxVector> = 0>
+auto rfft(const Array &x, CplxVector &&dst, int n = -1) {
+    scicpp_require(!x.empty());
+    rfft_inplace(x, dst, n);
     return std::move(dst);
 }
 
 template <class Array>
-auto rfft(const Array &x) {
+auto rfft(const Array &x, int n = -1) {
     using T = typename Array::value_type;
     std::vector<std::complex<T>> y;
-    return rfft(x, std::move(y));
+    return rfft(x, std::move(y), n);
 }
 
-// TODO Iterators interface for ifft
+// Inverse transform of size n of complex or real values
+template <class InputIt,
+          class CplxVector,
+          meta::disable_if_iterable<InputIt> = 0>
+void ifft_inplace(InputIt first, InputIt last, CplxVector &dst, int n = -1) {
+    using T = typename CplxVector::value_type::value_type;
 
-template <typename T>
-auto ifft(const std::vector<std::complex<T>> &y, int n = -1) {
-    Eigen::FFT<T> fft_engine;
+    const auto size = detail::transform_size(first, last, n);
+    dst.resize(size);
+
+    if (size == 1) {
+        dst.assign(1,
+                   first != last ? std::complex<T>(*first) : std::complex<T>{});
+    } else {
+        const auto src = detail::fft_input<std::complex<T>>(first, last, size);
+        detail::fft_engine<T>().inv(dst.data(), src, signed_size_t(size));
+    }
+}
+
+template <class Array, class CplxVector>
+void ifft_inplace(const Array &y, CplxVector &dst, int n = -1) {
+    ifft_inplace(y.cbegin(), y.cend(), dst, n);
+}
+
+template <class Array,
+          class CplxVector,
+          meta::enable_if_iterable<CplxVector> = 0>
+auto ifft(const Array &y, CplxVector &&dst, int n = -1) {
+    ifft_inplace(y, dst, n);
+    return std::move(dst);
+}
+
+template <class Array, meta::enable_if_iterable<Array> = 0>
+auto ifft(const Array &y, int n = -1) {
+    using T = meta::value_type_t<typename Array::value_type>;
     std::vector<std::complex<T>> x;
+    return ifft(y, std::move(x), n);
+}
 
-    if (int(y.size()) == n || n < 0) {
-        fft_engine.inv(x, y);
+// Real signal of size n (default 2 * (m - 1)) from the m values of the
+// half spectrum, truncated or zero-padded to n / 2 + 1 values
+template <class InputIt,
+          class Vector,
+          meta::disable_if_iterable<InputIt> = 0>
+void irfft_inplace(InputIt first, InputIt last, Vector &dst, int n = -1) {
+    using T = typename Vector::value_type;
+
+    const auto src_size = std::size_t(std::distance(first, last));
+    const auto size = n < 0 ? 2 * (src_size - 1) : std::size_t(n);
+    scicpp_require(src_size != 0 && size != 0);
+    dst.resize(size);
+
+    if (size == 1) {
+        dst[0] = std::real(*first);
     } else {
-        fft_engine.inv(x, zero_padding(y, std::size_t(n)));
+        const auto src =
+            detail::fft_input<std::complex<T>>(first, last, size / 2 + 1);
+        detail::fft_engine<T>().inv(dst.data(), src, signed_size_t(size));
     }
+}
 
-    return x;
+template <class Array, class Vector>
+void irfft_inplace(const Array &y, Vector &dst, int n = -1) {
+    irfft_inplace(y.cbegin(), y.cend(), dst, n);
 }
 
-namespace detail {
+template <class Array, class Vector, meta::enable_if_iterable<Vector> = 0>
+auto irfft(const Array &y, Vector &&dst, int n = -1) {
+    irfft_inplace(y, dst, n);
+    return std::move(dst);
+}
 
-template <typename T>
-auto to_complex(const std::vector<T> &y, std::size_t n) {
-    std::vector<std::complex<T>> x(n, std::complex<T>(T{0}, T{0}));
+template <class Array, meta::enable_if_iterable<Array> = 0>
+auto irfft(const Array &y, int n = -1) {
+    using T = typename Array::value_type::value_type;
+    std::vector<T> x;
+    return irfft(y, std::move(x), n);
+}
 
-    std::transform(y.cbegin(),
-                   y.cbegin() + int(std::min(n, y.size())),
-                   x.begin(),
-                   [](auto v) { return std::complex(v, T{0}); });
+//---------------------------------------------------------------------------------
+// Batched FFTs
+//
+// Transforms of nrows signals of the same length, stored contiguously
+// row by row, into a caller-provided buffer (resized if needed, so it is
+// reused across calls). The rows are transformed in parallel by nthreads
+// threads, all the rows of a thread sharing the plan of its engine.
+//---------------------------------------------------------------------------------
+
+namespace detail {
 
-    return x;
+template <class Func>
+void for_each_row(std::size_t nrows, std::size_t nthreads, Func &&func) {
+    global_thread_pool().parallel_for(
+        signed_size_t(nrows),
+        [&](signed_size_t i) { func(std::size_t(i)); },
+        std::max(nthreads, std::size_t(1)));
+}
+
+// Size of the rows of a batch of nrows signals
+scicpp_pure inline std::size_t batch_row_size(std::size_t size,
+                                              std::size_t nrows) {
+    scicpp_require(nrows > 0 && size > 0);
+    scicpp_require(size % nrows == 0);
+    return size / nrows;
 }
 
 } // namespace detail
 
-template <typename T>
-auto ifft(const std::vector<T> &y, int n = -1) {
-    Eigen::FFT<T> fft_engine;
-    std::vector<std::complex<T>> x;
-    const auto size = n < 0 ? y.size() : std::size_t(n);
-    fft_engine.inv(x, detail::to_complex(y, size));
-    return x;
+// Full spectrum of each row of x (real or complex)
+template <class Array, class CplxVector>
+void fft_batch(const Array &x,
+               std::size_t nrows,
+               CplxVector &y,
+               std::size_t nthreads = 1) {
+    using T = typename CplxVector::value_type::value_type;
+
+    const auto L = detail::batch_row_size(x.size(), nrows);
+    y.resize(x.size());
+
+    detail::for_each_row(nrows, nthreads, [&](std::size_t i) {
+        const auto src = x.data() + i * L;
+        const auto dst = y.data() + i * L;
+
+        if (L == 1) {
+            dst[0] = src[0];
+        } else {
+            detail::fft_engine<T>().fwd(dst, src, signed_size_t(L));
+        }
+    });
 }
 
-template <typename T>
-auto irfft(const std::vector<std::complex<T>> &y, int n = -1) {
-    Eigen::FFT<T> fft_engine;
-    std::vector<T> x;
+// Half spectrum (L / 2 + 1 values) of each real row of x of size L
+template <class Array, class CplxVector>
+void rfft_batch(const Array &x,
+                std::size_t nrows,
+                CplxVector &y,
+                std::size_t nthreads = 1) {
+    using T = typename CplxVector::value_type::value_type;
+    static_assert(!meta::is_complex_v<typename Array::value_type>);
 
-    if (int(y.size()) == n) {
-        fft_engine.inv(x, y);
-    } else {
-        const auto size = n < 0 ? 2 * (y.size() - 1) : std::size_t(n);
-        fft_engine.inv(x, zero_padding(y, size));
-    }
+    const auto L = detail::batch_row_size(x.size(), nrows);
+    const auto M = L / 2 + 1;
+    y.resize(nrows * M);
 
-    return x;
+    detail::for_each_row(nrows, nthreads, [&](std::size_t i) {
+        const auto src = x.data() + i * L;
+        const auto dst = y.data() + i * M;
+
+        if (L == 1) {
+            dst[0] = src[0];
+        } else {
+            detail::fft_engine<T, true>().fwd(dst, src, signed_size_t(L));
+        }
+    });
+}
+
+// Inverse transform of each complex row of y
+template <class CplxArray, class CplxVector>
+void ifft_batch(const CplxArray &y,
+                std::size_t nrows,
+                CplxVector &x,
+                std::size_t nthreads = 1) {
+    using T = typename CplxVector::value_type::value_type;
+    static_assert(meta::is_complex_v<typename CplxArray::value_type>);
+
+    const auto L = detail::batch_row_size(y.size(), nrows);
+    x.resize(y.size());
+
+    detail::for_each_row(nrows, nthreads, [&](std::size_t i) {
+        const auto src = y.data() + i * L;
+        const auto dst = x.data() + i * L;
+
+        if (L == 1) {
+            dst[0] = src[0];
+        } else {
+            detail::fft_engine<T>().inv(dst, src, signed_size_t(L));
+        }
+    });
+}
+
+// Real signals of size n from the half spectra in the rows of y.
+// The rows are truncated or zero-padded to n / 2 + 1 values
+// (n defaults to 2 * (M - 1) for rows of size M).
+template <class CplxArray, class Vector>
+void irfft_batch(const CplxArray &y,
+                 std::size_t nrows,
+                 Vector &x,
+                 int n = -1,
+                 std::size_t nthreads = 1) {
+    using T = typename Vector::value_type;
+    static_assert(meta::is_complex_v<typename CplxArray::value_type>);
+
+    const auto M = detail::batch_row_size(y.size(), nrows);
+    const auto L = n < 0 ? 2 * (M - 1) : std::size_t(n);
+    scicpp_require(L > 0);
+    const auto nbins = L / 2 + 1;
+    x.resize(nrows * L);
+
+    detail::for_each_row(nrows, nthreads, [&](std::size_t i) {
+        const auto src = y.data() + i * M;
+        const auto dst = x.data() + i * L;
+
+        if (M >= nbins) {
+            detail::fft_engine<T>().inv(dst, src, signed_size_t(L));
+        } else {
+            thread_local std::vector<std::complex<T>> row;
+            row.assign(nbins, std::complex<T>(T{0}, T{0}));
+            std::copy_n(src, M, row.begin());
+            detail::fft_engine<T>().inv(dst, row.data(), signed_size_t(L));
+        }
+    });
 }
 
 } // namespace scicpp::signal
@@ -11,6 +11,8 @@
 #include "scicpp/core/stats.hpp"
 #include "scicpp/signal/windows.hpp"
 
+#include <thread>
+
 namespace scicpp::signal {
 
 TEST_CASE("Forward complex FFT") {
@@ -145,7 +147,7 @@ TEST_CASE("Inverse real FFT") {
 TEST_CASE("Inverse complex FFT") {
     SECTION("Complex input vector") {
         std::vector y{1. + 3.i, 2. + 2.i, 3. + 1.i};
-        REQUIRE(almost_equal<5>(ifft(y),
+        REQUIRE(almost_equal<8>(ifft(y),
                                 {2. + 2.i,
                                  -0.7886751345948131 + 0.21132486540518697i,
                                  -0.21132486540518697 + 0.7886751345948131i}));
@@ -175,6 +177,172 @@ TEST_CASE("Inverse complex FFT") {
     }
 }
 
+TEST_CASE("FFT plan cache") {
+    SECTION("Interleaved sizes and directions") {
+        const auto x = random::rand<double>(64);
+        const auto y = random::rand<double>(35);
+
+        const auto X0 = fft(x);
+        const auto R0 = rfft(x);
+        const auto Y0 = rfft(y);
+        const auto y0 = irfft(Y0, 35);
+        const auto x0 = irfft(R0);
+
+        for (int i = 0; i < 3; ++i) {
+            REQUIRE(almost_equal(rfft(y), Y0));
+            REQUIRE(almost_equal(fft(x), X0));
+            REQUIRE(almost_equal(irfft(rfft(y), 35), y0));
+            REQUIRE(almost_equal(rfft(x), R0));
+            REQUIRE(almost_equal(irfft(R0), x0));
+        }
+    }
+
+    SECTION("Multiple threads") {
+        const auto x = random::rand<float>(128);
+        const auto X0 = rfft(x);
+        std::vector<std::vector<std::complex<float>>> res(4);
+        std::vector<std::thread> threads;
+
+        for (auto &r : res) {
+            threads.emplace_back([&]() {
+                for (int i = 0; i < 10; ++i) {
+                    r = rfft(x);
+                }
+            });
+        }
+
+        for (auto &thrd : threads) {
+            thrd.join();
+        }
+
+        for (const auto &r : res) {
+            REQUIRE(almost_equal(r, X0));
+        }
+    }
+}
+
+TEST_CASE("FFT output buffers") {
+    using namespace operators;
+
+    const auto x = random::rand<double>(12);
+    const auto z = random::rand<double>(12) + 1.0i * random::rand<double>(12);
+    std::vector<std::complex<double>> X;
+    std::vector<double> y;
+
+    SECTION("Iterators") {
+        fft_inplace(x.cbegin() + 2, x.cend(), X);
+        REQUIRE(almost_equal(X, fft(std::vector(x.cbegin() + 2, x.cend()))));
+        rfft_inplace(x.cbegin(), x.cbegin() + 7, X);
+        REQUIRE(
+            almost_equal(X, rfft(std::vector(x.cbegin(), x.cbegin() + 7))));
+        ifft_inplace(z.cbegin() + 1, z.cend(), X);
+        REQUIRE(almost_equal(X, ifft(std::vector(z.cbegin() + 1, z.cend()))));
+        irfft_inplace(z.cbegin(), z.cbegin() + 5, y);
+        REQUIRE(
+            almost_equal(y, irfft(std::vector(z.cbegin(), z.cbegin() + 5))));
+    }
+
+    SECTION("Padding and truncation") {
+        for (int n : {1, 5, 12, 16}) {
+            const auto N = std::size_t(n);
+            REQUIRE(almost_equal(fft(x, X, n), fft(zero_padding(x, N))));
+            REQUIRE(almost_equal(rfft(x, X, n), rfft(zero_padding(x, N))));
+            REQUIRE(almost_equal(ifft(z, X, n), ifft(zero_padding(z, N))));
+            REQUIRE(almost_equal(ifft(z, n), ifft(zero_padding(z, N))));
+            REQUIRE(almost_equal(ifft(x, n), ifft(zero_padding(x, N))));
+            REQUIRE(almost_equal(irfft(z, y, n),
+                                 irfft(zero_padding(z, N / 2 + 1), n)));
+        }
+    }
+
+    SECTION("Buffers are reused") {
+        fft_inplace(x, X);
+        const auto data = X.data();
+        irfft_inplace(z, y, 20);
+        const auto ydata = y.data();
+
+        for (int i = 0; i < 3; ++i) {
+            fft_inplace(x, X);
+            rfft_inplace(x, X, 8);
+            ifft_inplace(z, X, 10);
+            irfft_inplace(z, y, 16);
+            REQUIRE(X.data() == data);
+            REQUIRE(y.data() == ydata);
+        }
+    }
+}
+
+TEST_CASE("Batched FFTs") {
+    // Row i of a batch
+    const auto row = [](const auto &x, std::size_t nrows, std::size_t i) {
+        const auto L = x.size() / nrows;
+        using T = typename std::decay_t<decltype(x)>::value_type;
+        return std::vector<T>(x.cbegin() + signed_size_t(i * L),
+                              x.cbegin() + signed_size_t((i + 1) * L));
+    };
+
+    const std::size_t nrows = 7;
+
+    for (std::size_t L : {1U, 35U, 64U}) {
+        const auto x = random::rand<double>(nrows * L);
+        std::vector<std::complex<double>> X, R, xc;
+        std::vector<double> xr;
+
+        for (std::size_t nthreads : {1U, 3U}) {
+            fft_batch(x, nrows, X, nthreads);
+            rfft_batch(x, nrows, R, nthreads);
+            REQUIRE(X.size() == nrows * L);
+            REQUIRE(R.size() == nrows * (L / 2 + 1));
+
+            ifft_batch(X, nrows, xc, nthreads);
+            REQUIRE(xc.size() == x.size());
+
+            for (std::size_t i = 0; i < nrows; ++i) {
+                REQUIRE(almost_equal(row(X, nrows, i), fft(row(x, nrows, i))));
+                REQUIRE(
+                    almost_equal(row(R, nrows, i), rfft(row(x, nrows, i))));
+            }
+
+            for (std::size_t k = 0; k < x.size(); ++k) {
+                REQUIRE(std::abs(xc[k] - x[k]) < 1E-14);
+            }
+
+            if (L > 1) {
+                irfft_batch(R, nrows, xr, int(L), nthreads);
+                REQUIRE(xr.size() == x.size());
+
+                for (std::size_t i = 0; i < nrows; ++i) {
+                    REQUIRE(almost_equal(row(xr, nrows, i),
+                                         irfft(rfft(row(x, nrows, i)),
+                                               int(L))));
+                }
+
+                for (std::size_t k = 0; k < x.size(); ++k) {
+                    REQUIRE(std::abs(xr[k] - x[k]) < 1E-14);
+                }
+            }
+        }
+    }
+
+    SECTION("irfft size") {
+        using namespace operators;
+        const auto y =
+            random::rand<double>(3 * 9) + 1.0i * random::rand<double>(3 * 9);
+        std::vector<double> x;
+
+        for (int n : {-1, 10, 16, 17, 30}) {
+            irfft_batch(y, 3, x, n);
+            const auto L = n < 0 ? std::size_t(16) : std::size_t(n);
+            REQUIRE(x.size() == 3 * L);
+
+            for (std::size_t i = 0; i < 3; ++i) {
+                REQUIRE(almost_equal<4>(row(x, 3, i),
+                                        irfft(row(y, 3, i), int(L))));
+            }
+        }
+    }
+}
+
 TEST_CASE("fftfreq") {
     REQUIRE(almost_equal(
         fftfreq<4>(3.14),
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#include "filtering.hpp"
+
+#include "scicpp/core.hpp"
+
+namespace {
+
+// scipy.signal.butter(4, 0.2, output='sos')
+const std::vector<std::array<double, 6>> sos_butter4{
+    {0.00482434335771623,
+     0.00964868671543246,
+     0.00482434335771623,
+     1.,
+     -1.0485995763626117,
+     0.2961403575616696},
+    {1., 2., 1., 1., -1.3209134308194264, 0.6327387928852766}};
+
+} // namespace
+
+NONIUS_BENCHMARK("signal::sosfilt (double, 1000000)",
+                 [](nonius::chronometer meter) {
+                     const auto x = scicpp::random::rand<double>(1000000);
+
+                     meter.measure([&]() {
+                         return scicpp::signal::sosfilt(sos_butter4, x);
+                     });
+                 })
+
+NONIUS_BENCHMARK("signal::SosFilter (double, 64 channels x 1024)",
+                 [](nonius::chronometer meter) {
+                     const auto x = scicpp::random::rand<double>(64 * 1024);
+                     auto filt = scicpp::signal::SosFilter(sos_butter4, 64);
+                     std::vector<double> y(x.size());
+
+                     meter.measure([&]() {
+                         filt.filter(x, y);
+                         return y[0];
+                     });
+                 })
+
+NONIUS_BENCHMARK("signal::sosfiltfilt (double, 1000000)",
+                 [](nonius::chronometer meter) {
+                     const auto x = scicpp::random::rand<double>(1000000);
+
+                     meter.measure([&]() {
+                         return scicpp::signal::sosfiltfilt(sos_butter4, x);
+                     });
+                 })
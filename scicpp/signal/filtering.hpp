@@ -0,0 +1,725 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#ifndef SCICPP_SIGNAL_FILTERING
+#define SCICPP_SIGNAL_FILTERING
+
+#include "scicpp/core/macros.hpp"
+#include "scicpp/core/meta.hpp"
+#include "scicpp/core/thread_pool.hpp"
+#include "scicpp/signal/convolve.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace scicpp::signal {
+
+namespace detail {
+
+// Coefficients of a rational transfer function B(z) / A(z),
+// normalized such that a[0] = 1 and padded to the same size.
+template <typename T>
+struct TransferFunction {
+    std::vector<T> b;
+    std::vector<T> a;
+
+    template <class ArrayB, class ArrayA>
+    TransferFunction(const ArrayB &b_, const ArrayA &a_) {
+        static_assert(meta::is_iterable_v<ArrayB>);
+        static_assert(meta::is_iterable_v<ArrayA>);
+        scicpp_require(!b_.empty() && !a_.empty());
+        scicpp_require(std::abs(a_[0]) > 0);
+
+        const auto n = std::max(b_.size(), a_.size());
+        b.assign(n, T{0});
+        a.assign(n, T{0});
+
+        const auto a0 = T(a_[0]);
+        std::transform(
+            b_.cbegin(), b_.cend(), b.begin(), [=](auto v) { return v / a0; });
+        std::transform(
+            a_.cbegin(), a_.cend(), a.begin(), [=](auto v) { return v / a0; });
+    }
+
+    // Number of state variables
+    std::size_t order() const { return b.size() - 1; }
+};
+
+// Direct form II transposed filter on nsamples samples of C interleaved
+// channels (x[n * C + c]). The state is stored as z[k * C + c].
+//
+// The loops over the channels vectorize; C_static = 1 selects
+// the single channel loop. Filtering in place (x == y) is allowed.
+template <std::size_t C_static, typename T>
+void df2t_filter(const TransferFunction<T> &tf,
+                 T *z,
+                 const T *x,
+                 T *y,
+                 std::size_t nsamples,
+                 std::size_t nchans) {
+    const auto C = C_static > 0 ? C_static : nchans;
+    const auto K = tf.order();
+    const auto b = tf.b.data();
+    const auto a = tf.a.data();
+
+    if (K == 0) {
+        for (std::size_t i = 0; i < nsamples * C; ++i) {
+            y[i] = b[0] * x[i];
+        }
+
+        return;
+    }
+
+    // In place, the input samples are saved before being overwritten
+    std::vector<T> xsave(x == y ? C : 0);
+
+    for (std::size_t n = 0; n < nsamples; ++n) {
+        const T *xn = x + n * C;
+        const auto yn = y + n * C;
+
+        if (x == y) {
+            std::copy_n(xn, C, xsave.data());
+            xn = xsave.data();
+        }
+
+        for (std::size_t c = 0; c < C; ++c) {
+            yn[c] = b[0] * xn[c] + z[c];
+        }
+
+        for (std::size_t k = 0; k + 1 < K; ++k) {
+            const auto zk = z + k * C;
+            const auto zk1 = z + (k + 1) * C;
+
+            for (std::size_t c = 0; c < C; ++c) {
+                zk[c] = b[k + 1] * xn[c] + zk1[c] - a[k + 1] * yn[c];
+            }
+        }
+
+        const auto zK = z + (K - 1) * C;
+
+        for (std::size_t c = 0; c < C; ++c) {
+            zK[c] = b[K] * xn[c] - a[K] * yn[c];
+        }
+    }
+}
+
+// Second-order section normalized such that a0 = 1
+template <typename T>
+struct Biquad {
+    T b0, b1, b2, a1, a2;
+};
+
+template <class SOS>
+auto to_biquads(const SOS &sos) {
+    static_assert(meta::is_iterable_v<SOS>);
+    using T = typename SOS::value_type::value_type;
+    static_assert(std::is_same_v<typename SOS::value_type, std::array<T, 6>>);
+
+    std::vector<Biquad<T>> res;
+    res.reserve(sos.size());
+
+    for (const auto &s : sos) {
+        const auto a0 = s[3];
+        scicpp_require(std::abs(a0) > 0);
+        res.push_back({s[0] / a0, s[1] / a0, s[2] / a0, s[4] / a0, s[5] / a0});
+    }
+
+    return res;
+}
+
+// Biquad filter in place on nsamples samples of C interleaved channels,
+// with states z0[c] and z1[c].
+//
+// The states are passed as distinct pointers, else GCC doesn't vectorize
+// the loop over the channels (unknown distance C between z0 and z1).
+template <std::size_t C_static, typename T>
+void biquad_filter(const Biquad<T> &s,
+                   T *z0,
+                   T *z1,
+                   T *xy,
+                   std::size_t nsamples,
+                   std::size_t nchans) {
+    const auto C = C_static > 0 ? C_static : nchans;
+
+    for (std::size_t n = 0; n < nsamples; ++n) {
+        const auto xyn = xy + n * C;
+
+        for (std::size_t c = 0; c < C; ++c) {
+            const auto xn = xyn[c];
+            const auto yn = s.b0 * xn + z0[c];
+            z0[c] = s.b1 * xn - s.a1 * yn + z1[c];
+            z1[c] = s.b2 * xn - s.a2 * yn;
+            xyn[c] = yn;
+        }
+    }
+}
+
+} // namespace detail
+
+//---------------------------------------------------------------------------------
+// LFilter
+//
+// Streaming IIR or FIR filter B(z) / A(z) of one or several channels,
+// implemented as a direct form II transposed structure (as scipy lfilter).
+//
+// Blocks of any size are filtered continuously: the filter state is kept
+// between calls. Multichannel blocks are interleaved, x[n * nchannels + c],
+// and each sample is processed for all the channels at once, so the inner
+// loops vectorize across channels.
+//---------------------------------------------------------------------------------
+
+template <typename T = double>
+class LFilter {
+  public:
+    template <class ArrayB, class ArrayA>
+    LFilter(const ArrayB &b, const ArrayA &a, std::size_t nchannels = 1)
+        : m_tf(b, a), m_nchans(nchannels) {
+        scicpp_require(m_nchans > 0);
+    }
+
+    // Filter a block of samples (in place if x and y are the same vector)
+    void filter(const std::vector<T> &x, std::vector<T> &y) {
+        scicpp_require(x.size() % m_nchans == 0);
+        y.resize(x.size());
+        const auto nsamples = x.size() / m_nchans;
+
+        if (m_nchans == 1) {
+            detail::df2t_filter<1>(
+                m_tf, m_z.data(), x.data(), y.data(), nsamples, 1);
+        } else {
+            detail::df2t_filter<0>(
+                m_tf, m_z.data(), x.data(), y.data(), nsamples, m_nchans);
+        }
+    }
+
+    auto filter(const std::vector<T> &x) {
+        std::vector<T> y;
+        filter(x, y);
+        return y;
+    }
+
+    auto nchannels() const { return m_nchans; }
+
+    // Number of state variables per channel
+    auto order() const { return m_tf.order(); }
+
+    // Filter state z[k * nchannels + c]
+    const auto &state() const { return m_z; }
+
+    // Set the filter state, either of all the channels (size order() *
+    // nchannels()), or the same state zi for each channel (size order()).
+    void set_state(const std::vector<T> &zi) {
+        if (zi.size() == m_z.size()) {
+            m_z = zi;
+        } else {
+            scicpp_require(zi.size() == order());
+
+            for (std::size_t k = 0; k < order(); ++k) {
+                std::fill_n(m_z.begin() + signed_size_t(k * m_nchans),
+                            m_nchans,
+                            zi[k]);
+            }
+        }
+    }
+
+    // Clear the filter state (initial rest)
+    void reset() { std::fill(m_z.begin(), m_z.end(), T{0}); }
+
+  private:
+    detail::TransferFunction<T> m_tf;
+    std::size_t m_nchans;
+    std::vector<T> m_z = std::vector<T>(m_tf.order() * m_nchans, T{0});
+}; // class LFilter
+
+//---------------------------------------------------------------------------------
+// SosFilter
+//
+// Streaming cascade of second-order sections, with the same interface and
+// multichannel layout as LFilter.
+//
+// Sections are given as std::array{b0, b1, b2, a0, a1, a2} (scipy sos rows).
+// Blocks are processed by chunks small enough to stay in the L1 cache while
+// each section filters the chunk in place.
+//---------------------------------------------------------------------------------
+
+template <typename T = double>
+class SosFilter {
+  public:
+    template <class SOS>
+    explicit SosFilter(const SOS &sos, std::size_t nchannels = 1)
+        : m_sections(detail::to_biquads(sos)), m_nchans(nchannels) {
+        scicpp_require(m_nchans > 0);
+        scicpp_require(!m_sections.empty());
+    }
+
+    // Filter a block of samples (in place if x and y are the same vector)
+    void filter(const std::vector<T> &x, std::vector<T> &y) {
+        scicpp_require(x.size() % m_nchans == 0);
+
+        if (&x != &y) {
+            y.assign(x.cbegin(), x.cend());
+        }
+
+        const auto nsamples = x.size() / m_nchans;
+        const auto chunk = std::max(std::size_t(1), chunk_size / m_nchans);
+
+        for (std::size_t n0 = 0; n0 < nsamples; n0 += chunk) {
+            const auto len = std::min(chunk, nsamples - n0);
+            const auto xy = y.data() + n0 * m_nchans;
+
+            for (std::size_t s = 0; s < m_sections.size(); ++s) {
+                const auto z0 = m_z.data() + 2 * s * m_nchans;
+                const auto z1 = z0 + m_nchans;
+
+                if (m_nchans == 1) {
+                    detail::biquad_filter<1>(m_sections[s], z0, z1, xy, len, 1);
+                } else {
+                    detail::biquad_filter<0>(
+                        m_sections[s], z0, z1, xy, len, m_nchans);
+                }
+            }
+        }
+    }
+
+    auto filter(const std::vector<T> &x) {
+        std::vector<T> y;
+        filter(x, y);
+        return y;
+    }
+
+    auto nchannels() const { return m_nchans; }
+
+    auto nsections() const { return m_sections.size(); }
+
+    // Filter state z[(2 * s + k) * nchannels + c] of section s
+    const auto &state() const { return m_z; }
+
+    // Set the filter state, either of all the channels (size
+    // 2 * nsections() * nchannels()), or the same state for each channel
+    // given as one std::array{z0, z1} per section (as scipy sosfilt zi).
+    void set_state(const std::vector<T> &zi) {
+        scicpp_require(zi.size() == m_z.size());
+        m_z = zi;
+    }
+
+    void set_state(const std::vector<std::array<T, 2>> &zi) {
+        scicpp_require(zi.size() == nsections());
+
+        for (std::size_t s = 0; s < nsections(); ++s) {
+            for (std::size_t k = 0; k < 2; ++k) {
+                std::fill_n(m_z.begin() + signed_size_t((2 * s + k) * m_nchans),
+                            m_nchans,
+                            zi[s][k]);
+            }
+        }
+    }
+
+    // Clear the filter state (initial rest)
+    void reset() { std::fill(m_z.begin(), m_z.end(), T{0}); }
+
+  private:
+    // Number of values (samples x channels) filtered by all the sections
+    // before moving to the next chunk
+    static constexpr std::size_t chunk_size = 2048;
+
+    std::vector<detail::Biquad<T>> m_sections;
+    std::size_t m_nchans;
+    std::vector<T> m_z = std::vector<T>(2 * m_sections.size() * m_nchans, T{0});
+}; // class SosFilter
+
+//---------------------------------------------------------------------------------
+// lfilter
+//---------------------------------------------------------------------------------
+
+// Filter x with initial conditions zi, returns {y, zf}
+template <class ArrayB, class ArrayA, typename T>
+auto lfilter(const ArrayB &b,
+             const ArrayA &a,
+             const std::vector<T> &x,
+             const std::vector<T> &zi) {
+    LFilter<T> filt(b, a);
+    filt.set_state(zi);
+    auto y = filt.filter(x);
+    return std::tuple{y, filt.state()};
+}
+
+template <class ArrayB, class ArrayA, typename T>
+auto lfilter(const ArrayB &b, const ArrayA &a, const std::vector<T> &x) {
+    static_assert(meta::is_iterable_v<ArrayA>);
+
+    if (x.empty()) {
+        return std::vector<T>{};
+    }
+
+    // FIR filter: the first outputs of the convolution
+    if (a.size() == 1 && !b.empty()) {
+        scicpp_require(std::abs(a[0]) > 0);
+
+        std::vector<T> h(b.size());
+        std::transform(b.cbegin(), b.cend(), h.begin(), [&](auto v) {
+            return v / T(a[0]);
+        });
+
+        auto y = convolve(x, h);
+        y.resize(x.size());
+        return y;
+    }
+
+    return LFilter<T>(b, a).filter(x);
+}
+
+//---------------------------------------------------------------------------------
+// lfilter_zi
+//
+// Initial state for the steady state of the step response:
+// for an input x[n] = 1, the output is constant y = sum(b) / sum(a), so
+// zi[k] = sum_{j > k} (b[j] - a[j] * y).
+//---------------------------------------------------------------------------------
+
+template <class ArrayB, class ArrayA>
+auto lfilter_zi(const ArrayB &b, const ArrayA &a) {
+    static_assert(meta::is_iterable_v<ArrayB>);
+    using T = typename ArrayB::value_type;
+
+    const detail::TransferFunction<T> tf(b, a);
+    const auto K = tf.order();
+
+    const auto sum_b = std::accumulate(tf.b.cbegin(), tf.b.cend(), T{0});
+    const auto sum_a = std::accumulate(tf.a.cbegin(), tf.a.cend(), T{0});
+    scicpp_require(std::abs(sum_a) > 0);
+    const auto y = sum_b / sum_a;
+
+    std::vector<T> zi(K);
+    T acc{0};
+
+    for (std::size_t k = K; k-- > 0;) {
+        acc += tf.b[k + 1] - tf.a[k + 1] * y;
+        zi[k] = acc;
+    }
+
+    return zi;
+}
+
+//---------------------------------------------------------------------------------
+// sosfilt
+//---------------------------------------------------------------------------------
+
+// Filter x with initial conditions zi (one {z0, z1} per section),
+// returns {y, zf}
+template <class SOS, typename T>
+auto sosfilt(const SOS &sos,
+             const std::vector<T> &x,
+             const std::vector<std::array<T, 2>> &zi) {
+    SosFilter<T> filt(sos);
+    filt.set_state(zi);
+    auto y = filt.filter(x);
+
+    std::vector<std::array<T, 2>> zf(filt.nsections());
+
+    for (std::size_t s = 0; s < zf.size(); ++s) {
+        zf[s] = {filt.state()[2 * s], filt.state()[2 * s + 1]};
+    }
+
+    return std::tuple{y, zf};
+}
+
+template <class SOS, typename T>
+auto sosfilt(const SOS &sos, const std::vector<T> &x) {
+    return SosFilter<T>(sos).filter(x);
+}
+
+//---------------------------------------------------------------------------------
+// sosfilt_zi
+//
+// Initial state of each section for the steady state of the step response.
+// The step response of the previous sections scales the input of a section
+// by its DC gain sum(b) / sum(a).
+//---------------------------------------------------------------------------------
+
+template <class SOS>
+auto sosfilt_zi(const SOS &sos) {
+    using T = typename SOS::value_type::value_type;
+    const auto sections = detail::to_biquads(sos);
+
+    std::vector<std::array<T, 2>> zi(sections.size());
+    T scale{1};
+
+    for (std::size_t i = 0; i < sections.size(); ++i) {
+        const auto &s = sections[i];
+        const auto zi_s = lfilter_zi(std::array{s.b0, s.b1, s.b2},
+                                     std::array{T{1}, s.a1, s.a2});
+        zi[i] = {scale * zi_s[0], scale * zi_s[1]};
+        scale *= (s.b0 + s.b1 + s.b2) / (T{1} + s.a1 + s.a2);
+    }
+
+    return zi;
+}
+
+//---------------------------------------------------------------------------------
+// filtfilt, sosfiltfilt
+//
+// Forward-backward (zero-phase) filtering.
+//
+// The signal is extended by padlen samples on each side directly into the
+// output buffer, which is then filtered in place forward, reversed, filtered
+// in place backward and reversed again. Each pass starts from the steady
+// state of the step response scaled by the first sample of the pass.
+// Signals passed as rvalues are filtered in their own storage, so no buffer
+// is allocated if their capacity is sufficient.
+//---------------------------------------------------------------------------------
+
+// Signal extension at the edges (as scipy padtype 'odd', 'even', 'constant'
+// and None)
+enum PadType : int { ODD, EVEN, CONSTANT, NOPAD };
+
+namespace detail {
+
+// The buffer ext holds a signal of size n at offset padlen,
+// fill the padlen samples on each side.
+template <PadType padtype, typename T>
+void fill_padding(std::vector<T> &ext, std::size_t n, std::size_t padlen) {
+    if (padtype == NOPAD || padlen == 0) {
+        return;
+    }
+
+    const auto first = ext.begin() + signed_size_t(padlen);
+    const auto last = first + signed_size_t(n) - 1;
+
+    for (signed_size_t j = 0; j < signed_size_t(padlen); ++j) {
+        if constexpr (padtype == ODD) {
+            first[-1 - j] = T{2} * first[0] - first[1 + j];
+            last[1 + j] = T{2} * last[0] - last[-1 - j];
+        } else if constexpr (padtype == EVEN) {
+            first[-1 - j] = first[1 + j];
+            last[1 + j] = last[-1 - j];
+        } else {
+            first[-1 - j] = first[0];
+            last[1 + j] = last[0];
+        }
+    }
+}
+
+template <PadType padtype>
+scicpp_pure std::size_t
+checked_padlen(std::size_t n, int padlen, std::size_t default_len) {
+    if constexpr (padtype == NOPAD) {
+        return 0;
+    }
+
+    const auto len = padlen < 0 ? default_len : std::size_t(padlen);
+    // The extension mirrors the signal around its edge samples
+    scicpp_require(n > len);
+    return len;
+}
+
+// Move the signal x of size n in its own storage at offset padlen
+template <PadType padtype, typename T>
+void extend_inplace(std::vector<T> &x, std::size_t padlen) {
+    const auto n = x.size();
+    x.resize(n + 2 * padlen);
+    std::copy_backward(x.begin(),
+                       x.begin() + signed_size_t(n),
+                       x.begin() + signed_size_t(n + padlen));
+    fill_padding<padtype>(x, n, padlen);
+}
+
+template <PadType padtype, typename T>
+auto extend(const std::vector<T> &x, std::size_t padlen) {
+    std::vector<T> ext(x.size() + 2 * padlen);
+    std::copy(x.cbegin(), x.cend(), ext.begin() + signed_size_t(padlen));
+    fill_padding<padtype>(ext, x.size(), padlen);
+    return ext;
+}
+
+template <typename T>
+auto scale_state(std::vector<T> zi, T x0) {
+    for (auto &z : zi) {
+        z *= x0;
+    }
+
+    return zi;
+}
+
+template <typename T>
+auto scale_state(std::vector<std::array<T, 2>> zi, T x0) {
+    for (auto &z : zi) {
+        z = {x0 * z[0], x0 * z[1]};
+    }
+
+    return zi;
+}
+
+// Filter forward and backward in place the extended signal ext,
+// then keep the n samples of the original signal.
+template <class Filter, class State, typename T>
+void filtfilt_inplace(Filter filt,
+                      const State &zi,
+                      std::vector<T> &ext,
+                      std::size_t padlen) {
+    const auto n = ext.size() - 2 * padlen;
+
+    if (n == 0) {
+        ext.clear();
+        return;
+    }
+
+    filt.set_state(scale_state(zi, ext.front()));
+    filt.filter(ext, ext);
+    std::reverse(ext.begin(), ext.end());
+
+    filt.set_state(scale_state(zi, ext.front()));
+    filt.filter(ext, ext);
+
+    const auto first = ext.begin() + signed_size_t(padlen);
+    const auto last = first + signed_size_t(n);
+    std::reverse(first, last);
+    std::move(first, last, ext.begin());
+    ext.resize(n);
+}
+
+template <PadType padtype, class Filter, class State, typename T>
+auto filtfilt_channels(const Filter &filt,
+                       const State &zi,
+                       std::vector<std::vector<T>> &&channels,
+                       int padlen,
+                       std::size_t default_padlen,
+                       std::size_t nthreads) {
+    global_thread_pool().parallel_for(
+        signed_size_t(channels.size()),
+        [&](signed_size_t i) {
+            auto &x = channels[std::size_t(i)];
+            const auto len =
+                checked_padlen<padtype>(x.size(), padlen, default_padlen);
+            extend_inplace<padtype>(x, len);
+            filtfilt_inplace(filt, zi, x, len);
+        },
+        std::max(nthreads, std::size_t(1)),
+        1);
+
+    return std::move(channels);
+}
+
+template <class ArrayB, class ArrayA>
+std::size_t filtfilt_padlen(const ArrayB &b, const ArrayA &a) {
+    return 3 * std::max(b.size(), a.size());
+}
+
+// Number of taps of the equivalent transfer function (as scipy sosfiltfilt)
+template <class SOS>
+std::size_t sosfiltfilt_padlen(const SOS &sos) {
+    std::size_t b2_zeros = 0;
+    std::size_t a2_zeros = 0;
+
+    for (const auto &s : sos) {
+        b2_zeros += !(std::abs(s[2]) > 0);
+        a2_zeros += !(std::abs(s[5]) > 0);
+    }
+
+    return 3 * (2 * sos.size() + 1 - std::min(b2_zeros, a2_zeros));
+}
+
+} // namespace detail
+
+// padlen < 0 selects the default padding length 3 * max(a.size(), b.size()).
+template <PadType padtype = ODD, class ArrayB, class ArrayA, typename T>
+auto filtfilt(const ArrayB &b,
+              const ArrayA &a,
+              std::vector<T> &&x,
+              int padlen = -1) {
+    const auto len = detail::checked_padlen<padtype>(
+        x.size(), padlen, detail::filtfilt_padlen(b, a));
+    detail::extend_inplace<padtype>(x, len);
+    detail::filtfilt_inplace(LFilter<T>(b, a), lfilter_zi(b, a), x, len);
+    return std::move(x);
+}
+
+template <PadType padtype = ODD, class ArrayB, class ArrayA, typename T>
+auto filtfilt(const ArrayB &b,
+              const ArrayA &a,
+              const std::vector<T> &x,
+              int padlen = -1) {
+    const auto len = detail::checked_padlen<padtype>(
+        x.size(), padlen, detail::filtfilt_padlen(b, a));
+    auto ext = detail::extend<padtype>(x, len);
+    detail::filtfilt_inplace(LFilter<T>(b, a), lfilter_zi(b, a), ext, len);
+    return ext;
+}
+
+// Filter independent channels, in parallel on up to nthreads threads
+template <PadType padtype = ODD, class ArrayB, class ArrayA, typename T>
+auto filtfilt(const ArrayB &b,
+              const ArrayA &a,
+              std::vector<std::vector<T>> &&channels,
+              int padlen = -1,
+              std::size_t nthreads = 1) {
+    return detail::filtfilt_channels<padtype>(LFilter<T>(b, a),
+                                              lfilter_zi(b, a),
+                                              std::move(channels),
+                                              padlen,
+                                              detail::filtfilt_padlen(b, a),
+                                              nthreads);
+}
+
+template <PadType padtype = ODD, class ArrayB, class ArrayA, typename T>
+auto filtfilt(const ArrayB &b,
+              const ArrayA &a,
+              const std::vector<std::vector<T>> &channels,
+              int padlen = -1,
+              std::size_t nthreads = 1) {
+    return filtfilt<padtype>(
+        b, a, std::vector<std::vector<T>>(channels), padlen, nthreads);
+}
+
+// padlen < 0 selects the default padding length of scipy.signal.sosfiltfilt.
+template <PadType padtype = ODD, class SOS, typename T>
+auto sosfiltfilt(const SOS &sos, std::vector<T> &&x, int padlen = -1) {
+    const auto len = detail::checked_padlen<padtype>(
+        x.size(), padlen, detail::sosfiltfilt_padlen(sos));
+    detail::extend_inplace<padtype>(x, len);
+    detail::filtfilt_inplace(SosFilter<T>(sos), sosfilt_zi(sos), x, len);
+    return std::move(x);
+}
+
+template <PadType padtype = ODD, class SOS, typename T>
+auto sosfiltfilt(const SOS &sos, const std::vector<T> &x, int padlen = -1) {
+    const auto len = detail::checked_padlen<padtype>(
+        x.size(), padlen, detail::sosfiltfilt_padlen(sos));
+    auto ext = detail::extend<padtype>(x, len);
+    detail::filtfilt_inplace(SosFilter<T>(sos), sosfilt_zi(sos), ext, len);
+    return ext;
+}
+
+// Filter independent channels, in parallel on up to nthreads threads
+template <PadType padtype = ODD, class SOS, typename T>
+auto sosfiltfilt(const SOS &sos,
+                 std::vector<std::vector<T>> &&channels,
+                 int padlen = -1,
+                 std::size_t nthreads = 1) {
+    return detail::filtfilt_channels<padtype>(SosFilter<T>(sos),
+                                              sosfilt_zi(sos),
+                                              std::move(channels),
+                                              padlen,
+                                              detail::sosfiltfilt_padlen(sos),
+                                              nthreads);
+}
+
+template <PadType padtype = ODD, class SOS, typename T>
+auto sosfiltfilt(const SOS &sos,
+                 const std::vector<std::vector<T>> &channels,
+                 int padlen = -1,
+                 std::size_t nthreads = 1) {
+    return sosfiltfilt<padtype>(
+        sos, std::vector<std::vector<T>>(channels), padlen, nthreads);
+}
+
+} // namespace scicpp::signal
+
+#endif // SCICPP_SIGNAL_FILTERING
@@ -0,0 +1,390 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#include "filtering.hpp"
+
+#include "scicpp/core/equal.hpp"
+#include "scicpp/core/random.hpp"
+
+#include <cmath>
+
+namespace scicpp::signal {
+
+namespace {
+
+// x[n] = cos(0.3 n) + 0.1 n
+auto test_signal(std::size_t n) {
+    std::vector<double> x(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = std::cos(0.3 * double(i)) + 0.1 * double(i);
+    }
+
+    return x;
+}
+
+// scipy.signal.butter(3, 0.2)
+const std::array b_butter3{0.01809893300751443,
+                           0.05429679902254328,
+                           0.05429679902254328,
+                           0.01809893300751443};
+const std::array a_butter3{
+    1., -1.7600418803431688, 1.182893262037831, -0.27805991763454646};
+
+// scipy.signal.butter(4, 0.2, output='sos')
+const std::vector<std::array<double, 6>> sos_butter4{
+    {0.00482434335771623,
+     0.00964868671543246,
+     0.00482434335771623,
+     1.,
+     -1.0485995763626117,
+     0.2961403575616696},
+    {1., 2., 1., 1., -1.3209134308194264, 0.6327387928852766}};
+
+auto max_abs_diff(const std::vector<double> &x,
+                  const std::vector<double> &y) {
+    REQUIRE(x.size() == y.size());
+    double res = 0.0;
+
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        res = std::max(res, std::abs(x[i] - y[i]));
+    }
+
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("lfilter") {
+    const auto x = test_signal(16);
+
+    SECTION("IIR") {
+        REQUIRE(almost_equal<64>(
+            lfilter(b_butter3, a_butter3, x),
+            {0.01809893300751443, 0.10525214352236384, 0.29399474756880906,
+             0.5457265299026404,  0.7806147836089001,  0.9304479037083474,
+             0.9617981744818442,  0.8778030692655734,  0.7082866581383354,
+             0.49637346232862034, 0.28678383460623913, 0.1180327394718584,
+             0.01859697455841258, 0.00600008482335684, 0.08751922867404663,
+             0.261498654324159}));
+    }
+
+    SECTION("FIR") {
+        const std::vector<double> expected{
+            0.5,                 1.5276682445628031,  3.0680042965804457,
+            3.0691453327334197,  2.840792267873519,   2.430141307716522,
+            1.90067278603617,    1.3264806555085389,  0.7856538955898895,
+            0.35330105655043786, 0.09484103637084823, 0.06015940541953074,
+            0.27915227702339357, 0.7590557767024857,  1.4837996606282897,
+            2.415442822643701};
+
+        REQUIRE(almost_equal<64>(
+            lfilter(std::array{1., 2., 3.}, std::array{2.}, x), expected));
+        // Same filter through the direct form II transposed structure
+        REQUIRE(almost_equal<64>(
+            LFilter(std::array{1., 2., 3.}, std::array{2.}).filter(x),
+            expected));
+    }
+
+    SECTION("Initial conditions") {
+        using namespace scicpp::operators;
+
+        const auto zi = lfilter_zi(b_butter3, a_butter3);
+        REQUIRE(almost_equal<64>(
+            zi, {0.9819010669924833, -0.8324376123732247, 0.2961588506420602}));
+
+        const auto [y, zf] = lfilter(b_butter3, a_butter3, x, zi * x[0]);
+        REQUIRE(almost_equal<64>(
+            y,
+            {0.9999999999999977, 1.0010015314095533, 1.0052258790509152,
+             1.0109745223219415, 1.0072322228478325, 0.9767302420146126,
+             0.90455960473683,   0.7853269496988976, 0.626101196426798,
+             0.44519723450698223, 0.26821425706834623, 0.12303303765734848,
+             0.03513347923461015, 0.02402675137546422, 0.10107637931121136,
+             0.26863432395042625}));
+        REQUIRE(almost_equal<64>(zf,
+                                 {0.4897115686124825,
+                                  -0.2031954722207821,
+                                  0.09802965845057611}));
+
+        REQUIRE(almost_equal<2>(lfilter_zi(std::array{1., 2., 3.},
+                                           std::array{2., 0.5}),
+                                {1.9, 1.5}));
+        REQUIRE(lfilter_zi(std::array{2.}, std::array{1.}).empty());
+    }
+
+    SECTION("Empty") {
+        REQUIRE(lfilter(b_butter3, a_butter3, std::vector<double>{}).empty());
+    }
+}
+
+TEST_CASE("sosfilt") {
+    const auto x = test_signal(16);
+
+    SECTION("Zero initial conditions") {
+        const std::vector<double> expected{
+            4.8243433577162282e-03,  3.5820023349554461e-02,
+            1.2797039014280553e-01,  2.9950610708941200e-01,
+            5.2676729210249174e-01,  7.5240179612301283e-01,
+            9.1340284497799240e-01,  9.6652658874336816e-01,
+            9.0097110762114208e-01,  7.3746602609524325e-01,
+            5.1815419797570883e-01,  2.9316877730117169e-01,
+            1.0876823384824919e-01,  -3.1635514281945498e-04,
+            -1.3870377173930144e-02, 7.4433020568658081e-02};
+
+        const auto y = sosfilt(sos_butter4, x);
+        REQUIRE(y.size() == expected.size());
+
+        for (std::size_t i = 0; i < y.size(); ++i) {
+            REQUIRE(std::abs(y[i] - expected[i]) < 1E-15);
+        }
+    }
+
+    SECTION("Initial conditions") {
+        // scipy.signal.sosfilt_zi(sos) * x[0], with x[0] = 1
+        const std::vector<std::array<double, 2>> zi{
+            {0.07313199715874633, -0.01826167519702827},
+            {0.9220436594835377, -0.5547824523688142}};
+
+        const auto [y, zf] = sosfilt(sos_butter4, x, zi);
+        REQUIRE(std::abs(y[0] - 1.0000000000000002) < 1E-12);
+        REQUIRE(std::abs(y[15] - 0.09874031102026364) < 1E-12);
+        REQUIRE(zf.size() == 2);
+        REQUIRE(std::abs(zf[0][0] - 0.0490322076877255) < 1E-12);
+        REQUIRE(std::abs(zf[0][1] + 0.00468623010265674) < 1E-12);
+        REQUIRE(std::abs(zf[1][0] - 0.21277995408565442) < 1E-12);
+        REQUIRE(std::abs(zf[1][1] + 0.02565038954293535) < 1E-12);
+    }
+}
+
+TEST_CASE("Streaming filters") {
+    const auto x = test_signal(1000);
+
+    // Interleave channels: channel c is x scaled by c + 1
+    const std::size_t nchans = 5;
+    std::vector<double> xm(x.size() * nchans);
+
+    for (std::size_t n = 0; n < x.size(); ++n) {
+        for (std::size_t c = 0; c < nchans; ++c) {
+            xm[n * nchans + c] = double(c + 1) * x[n];
+        }
+    }
+
+    const auto filter_by_blocks = [&](auto filt, const auto &input) {
+        std::vector<double> res, block_res;
+        std::size_t n0 = 0;
+
+        for (std::size_t len : {1U, 7U, 100U, 0U, 392U, 500U}) {
+            len = std::min(len, input.size() / filt.nchannels() - n0);
+            const std::vector<double> block(
+                input.cbegin() + signed_size_t(n0 * filt.nchannels()),
+                input.cbegin() + signed_size_t((n0 + len) * filt.nchannels()));
+            filt.filter(block, block_res);
+            res.insert(res.end(), block_res.cbegin(), block_res.cend());
+            n0 += len;
+        }
+
+        REQUIRE(n0 * filt.nchannels() == input.size());
+        return res;
+    };
+
+    SECTION("LFilter") {
+        LFilter filt(b_butter3, a_butter3);
+        const auto y = filt.filter(x);
+        REQUIRE(array_equal(filter_by_blocks(LFilter(b_butter3, a_butter3), x),
+                            y));
+        REQUIRE(filt.state().size() == 3);
+
+        filt.reset();
+        REQUIRE(array_equal(filt.filter(x), y));
+
+        const auto ym =
+            filter_by_blocks(LFilter(b_butter3, a_butter3, nchans), xm);
+
+        for (std::size_t n = 0; n < x.size(); ++n) {
+            for (std::size_t c = 0; c < nchans; ++c) {
+                REQUIRE(std::abs(ym[n * nchans + c] - double(c + 1) * y[n]) <
+                        1E-12);
+            }
+        }
+    }
+
+    SECTION("SosFilter") {
+        SosFilter filt(sos_butter4);
+        const auto y = filt.filter(x);
+        REQUIRE(array_equal(filter_by_blocks(SosFilter<double>(sos_butter4), x),
+                            y));
+        REQUIRE(filt.state().size() == 4);
+
+        filt.reset();
+        auto y_inplace = x;
+        filt.filter(y_inplace, y_inplace);
+        REQUIRE(array_equal(y_inplace, y));
+
+        const auto ym =
+            filter_by_blocks(SosFilter<double>(sos_butter4, nchans), xm);
+
+        for (std::size_t n = 0; n < x.size(); ++n) {
+            for (std::size_t c = 0; c < nchans; ++c) {
+                REQUIRE(std::abs(ym[n * nchans + c] - double(c + 1) * y[n]) <
+                        1E-12);
+            }
+        }
+    }
+
+    SECTION("Initial state") {
+        LFilter<double> filt(b_butter3, a_butter3, nchans);
+        filt.set_state(lfilter_zi(b_butter3, a_butter3));
+        const auto y = filt.filter(std::vector<double>(10 * nchans, 1.0));
+
+        for (auto v : y) {
+            REQUIRE(std::abs(v - 1.0) < 1E-12);
+        }
+    }
+}
+
+TEST_CASE("filtfilt") {
+    const auto x = test_signal(32);
+
+    SECTION("Odd extension") {
+        const std::vector<double> expected{
+            0.9993338299507942, 0.9837446904397086, 0.9443760660895579,
+            0.8634127857271912, 0.736011127412684, 0.5713273018867059,
+            0.3898003346770988, 0.21828959156593752, 0.08474451582006402,
+            0.013615877257412843, 0.022615200038883624, 0.12093536842461516,
+            0.3087500010549601, 0.5776969321356485, 0.9120587612730341,
+            1.2904132430871929, 1.6875901400497737, 2.0768161276299266,
+            2.4319513795248264, 2.7297245574021187, 2.9518599546186506,
+            3.086959794726608, 3.131953404741486, 3.092858428111132,
+            2.9845412756256566, 2.829162937921438, 2.653118600512648,
+            2.482585545361156, 2.338294131276046, 2.230736822656576,
+            2.157483528292175, 2.104168088446026};
+
+        REQUIRE(max_abs_diff(filtfilt(b_butter3, a_butter3, x), expected) <
+                1E-12);
+        // Filtered in the storage of the input signal
+        REQUIRE(max_abs_diff(filtfilt(b_butter3, a_butter3, test_signal(32)),
+                             expected) < 1E-12);
+    }
+
+    SECTION("Padding types") {
+        REQUIRE(max_abs_diff(
+                    filtfilt<EVEN>(b_butter3, a_butter3, x, 10),
+                    {
+            1.0900416799013815, 1.069126564255429, 1.0002919738795355,
+            0.88604920202244, 0.7334427372313256, 0.5555642201859625,
+            0.37137166351135914, 0.20377223294576122, 0.07660922266618675,
+            0.01137082392064291, 0.02430840332968861, 0.12439601978374537,
+            0.3123066119015134, 0.5803873526506115, 0.9135014429035868,
+            1.2905516720086236, 1.6864880999062177, 2.07460647378785,
+            2.428951644410553, 2.7266454444931116, 2.949961025221522,
+            3.0879685688963803, 3.1375858045981335, 3.103888298669633,
+            2.999578916687607, 2.8435937976659256, 2.6589401507869184,
+            2.4700128699849877, 2.2997924341252403, 2.167423476136044,
+            2.086616169103206, 2.0649849329727425}) < 1E-12);
+        REQUIRE(max_abs_diff(
+                    filtfilt<CONSTANT>(b_butter3, a_butter3, x, 5),
+                    {
+            1.0462722845609067, 1.0274880722986373, 0.9727878327078162,
+            0.8747258536045281, 0.7344746052463148, 0.5631351058193792,
+            0.38033736199996937, 0.21089092212369948, 0.08063694182254215,
+            0.012516054331169106, 0.023504417626797666, 0.12269617590829072,
+            0.31053316238424744, 0.5790277514641136, 0.9127690186342141,
+            1.290505378318194, 1.6871225909249683, 2.0758618896949876,
+            2.4306394528932556, 2.728333742837177, 2.950901673831755,
+            3.087167957175072, 3.1341052353196783, 3.0973929727202996,
+            2.991029835786095, 2.835811013919265, 2.65660994653301,
+            2.478653869271472, 2.323344235046645, 2.2045600884986203,
+            2.126606409172975, 2.0847419826206735}) < 1E-12);
+        REQUIRE(max_abs_diff(
+                    filtfilt<NOPAD>(b_butter3, a_butter3, x),
+                    {
+            1.046257861468183, 1.02746402182019, 0.9727591508771698,
+            0.8747042007619319, 0.7344775461343475, 0.5631815232818438,
+            0.380438340145723, 0.21103725957027156, 0.08078724495442899,
+            0.01259233527549498, 0.02340382727393963, 0.12232596010625667,
+            0.3098692709424966, 0.578185099449835, 0.9120551205212726,
+            1.290414556620986, 1.6882245339584292, 2.0785571104718406,
+            2.4348035586753536, 2.7329512161947456, 2.9538801625529403,
+            3.0855869796901287, 3.125132639889729, 3.0799415276799884,
+            2.967898021037022, 2.815600301279743, 2.654288151571091,
+            2.513514881941839, 2.413657865793034, 2.3597523520734516,
+            2.3405211783347633, 2.3372310397941716}) < 1E-12);
+        REQUIRE(filtfilt<NOPAD>(b_butter3, a_butter3, std::vector<double>{})
+                    .empty());
+    }
+
+    SECTION("Channels") {
+        const std::vector<std::vector<double>> channels{
+            x, test_signal(50), test_signal(13)};
+        const auto y = filtfilt(b_butter3, a_butter3, channels, -1, 2);
+        REQUIRE(y.size() == 3);
+
+        for (std::size_t i = 0; i < y.size(); ++i) {
+            REQUIRE(array_equal(y[i],
+                                filtfilt(b_butter3, a_butter3, channels[i])));
+        }
+    }
+}
+
+TEST_CASE("sosfiltfilt") {
+    const auto x = test_signal(32);
+
+    SECTION("sosfilt_zi") {
+        const auto zi = sosfilt_zi(sos_butter4);
+        REQUIRE(zi.size() == 2);
+        REQUIRE(std::abs(zi[0][0] - 0.07313199715874633) < 1E-15);
+        REQUIRE(std::abs(zi[0][1] + 0.01826167519702827) < 1E-15);
+        REQUIRE(std::abs(zi[1][0] - 0.9220436594835377) < 1E-15);
+        REQUIRE(std::abs(zi[1][1] + 0.5547824523688142) < 1E-15);
+    }
+
+    SECTION("Odd extension") {
+        const std::vector<double> expected{
+            0.99515515085235, 0.9886615094608258, 0.9563945319324759,
+            0.8798907480010886, 0.753688825220124, 0.5866606505294631,
+            0.39970808640517463, 0.2209695429100981, 0.0801205681914384,
+            0.003201101322747899, 0.008889834468554101, 0.1065475680526463,
+            0.29587134664920073, 0.5677342227805479, 0.9057286771069192,
+            1.2880229580187137, 1.6892986857892462, 2.0826950278360616,
+            2.44179178322128, 2.742695007503042, 2.966236341621846,
+            3.1001693338321488, 3.141071110225213, 3.09548924271434,
+            2.9797891452410483, 2.8182430537534104, 2.6392194027739637,
+            2.4698734387426233, 2.3303891198724647, 2.2293441754908265,
+            2.1618637383298704, 2.111653569230998};
+
+        REQUIRE(max_abs_diff(sosfiltfilt(sos_butter4, x), expected) < 1E-12);
+        REQUIRE(max_abs_diff(sosfiltfilt(sos_butter4, test_signal(32)),
+                             expected) < 1E-12);
+    }
+
+    SECTION("Even extension") {
+        REQUIRE(max_abs_diff(
+                    sosfiltfilt<EVEN>(sos_butter4, x, 7),
+                    {
+            1.0972236866810543, 1.0800860413591538, 1.0110034052190093,
+            0.8940922009925263, 0.7382532996094114, 0.5576553207257009,
+            0.3714055394409113, 0.20205698668925443, 0.07310222873384851,
+            0.005966633488653346, 0.017134622389523884, 0.115949498479074,
+            0.3034109327326698, 0.5720514517104935, 0.9067761899031958,
+            1.2864336872636317, 1.685851403528715, 2.078097589010396,
+            2.4367906850586634, 2.7383370597890306, 2.9640115642592018,
+            3.101787388460637, 3.1477712882304965, 3.107025805275092,
+            2.9934999098006476, 2.8287956515748034, 2.6396208517780138,
+            2.4540395731663467, 2.2970022751709354, 2.186016098192509,
+            2.1280459127955482, 2.118661209940291}) < 1E-12);
+    }
+
+    SECTION("Channels") {
+        const std::vector<std::vector<double>> channels{
+            x, test_signal(50), test_signal(16)};
+        const auto y = sosfiltfilt(sos_butter4, channels, -1, 2);
+        REQUIRE(y.size() == 3);
+
+        for (std::size_t i = 0; i < y.size(); ++i) {
+            REQUIRE(array_equal(y[i], sosfiltfilt(sos_butter4, channels[i])));
+        }
+    }
+}
+
+} // namespace scicpp::signal
@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#include "fir_filter_design.hpp"
+
+#include <array>
+
+NONIUS_BENCHMARK("signal::remez (double, 101 taps)",
+                 [](nonius::chronometer meter) {
+                     meter.measure([&]() {
+                         scicpp::signal::clear_fir_design_cache();
+                         return scicpp::signal::remez(
+                             101,
+                             std::array{0.0, 0.1, 0.15, 0.5},
+                             std::array{1.0, 0.0});
+                     });
+                 })
+
+NONIUS_BENCHMARK("signal::remez (double, 101 taps, cached)",
+                 [](nonius::chronometer meter) {
+                     meter.measure([&]() {
+                         return scicpp::signal::remez(
+                             101,
+                             std::array{0.0, 0.1, 0.15, 0.5},
+                             std::array{1.0, 0.0});
+                     });
+                 })
+
+NONIUS_BENCHMARK("signal::firwin2 (double, 255 taps)",
+                 [](nonius::chronometer meter) {
+                     meter.measure([&]() {
+                         scicpp::signal::clear_fir_design_cache();
+                         return scicpp::signal::firwin2(
+                             255,
+                             std::array{0.0, 0.3, 0.3, 1.0},
+                             std::array{1.0, 1.0, 0.0, 0.0});
+                     });
+                 })
@@ -0,0 +1,746 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#ifndef SCICPP_SIGNAL_FIR_FILTER_DESIGN
+#define SCICPP_SIGNAL_FIR_FILTER_DESIGN
+
+#include "scicpp/core/constants.hpp"
+#include "scicpp/core/macros.hpp"
+#include "scicpp/core/meta.hpp"
+#include "scicpp/core/units/maths.hpp"
+#include "scicpp/signal/fft.hpp"
+#include "scicpp/signal/windows.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace scicpp::signal {
+
+//---------------------------------------------------------------------------------
+// Design cache
+//
+// Filter coefficients are memoized by their design parameters, so that
+// a filter designed for each channel, or each time a pipeline starts,
+// is computed only once. The cache is shared by all the threads.
+//---------------------------------------------------------------------------------
+
+namespace detail {
+
+enum FirDesign : int { FIRWIN, FIRWIN2, REMEZ };
+
+template <typename T>
+struct FirDesignCache {
+    std::mutex mtx;
+    std::map<std::vector<T>, std::vector<T>> designs;
+};
+
+template <typename T>
+auto &fir_design_cache() {
+    static FirDesignCache<T> cache;
+    return cache;
+}
+
+// Parameters are appended to the key, arrays preceded by their size
+template <typename T, class Param>
+void append_to_key(std::vector<T> &key, const Param &param) {
+    if constexpr (meta::is_iterable_v<Param>) {
+        key.push_back(T(param.size()));
+
+        for (const auto v : param) {
+            key.push_back(T(v));
+        }
+    } else {
+        key.push_back(T(param));
+    }
+}
+
+template <typename T, class Design, typename... Params>
+std::vector<T>
+cached_design(FirDesign id, Design &&design, const Params &...params) {
+    std::vector<T> key{T(id)};
+    (append_to_key(key, params), ...);
+
+    auto &cache = fir_design_cache<T>();
+
+    {
+        std::lock_guard lock(cache.mtx);
+        const auto it = cache.designs.find(key);
+
+        if (it != cache.designs.end()) {
+            return it->second;
+        }
+    }
+
+    // The design is computed without holding the lock
+    auto h = design();
+
+    std::lock_guard lock(cache.mtx);
+    cache.designs.emplace(std::move(key), h);
+    return h;
+}
+
+} // namespace detail
+
+// Number of filter designs in the cache
+template <typename T = double>
+std::size_t fir_design_cache_size() {
+    auto &cache = detail::fir_design_cache<T>();
+    std::lock_guard lock(cache.mtx);
+    return cache.designs.size();
+}
+
+template <typename T = double>
+void clear_fir_design_cache() {
+    auto &cache = detail::fir_design_cache<T>();
+    std::lock_guard lock(cache.mtx);
+    cache.designs.clear();
+}
+
+//---------------------------------------------------------------------------------
+// firwin
+//
+// FIR filter design using the window method: the ideal response of the
+// pass bands (sum of sinc functions) is multiplied by the window.
+//---------------------------------------------------------------------------------
+
+namespace detail {
+
+// Band edges normalized to the Nyquist frequency:
+// {0 if pass_zero, cutoffs..., 1 if the Nyquist frequency is in a pass band}
+template <class Cutoff, typename T>
+auto firwin_band_edges(const Cutoff &cutoff, bool pass_zero, T fs) {
+    std::vector<T> edges;
+
+    if (pass_zero) {
+        edges.push_back(T{0});
+    }
+
+    const auto nyq = fs / T{2};
+
+    if constexpr (meta::is_iterable_v<Cutoff>) {
+        scicpp_require(!cutoff.empty());
+
+        for (const auto f : cutoff) {
+            edges.push_back(T(f) / nyq);
+        }
+    } else {
+        edges.push_back(T(cutoff) / nyq);
+    }
+
+    for (std::size_t i = std::size_t(pass_zero); i < edges.size(); ++i) {
+        scicpp_require(edges[i] > T{0} && edges[i] < T{1});
+        scicpp_require(i == 0 || edges[i] > edges[i - 1]);
+    }
+
+    if (edges.size() % 2 == 1) {
+        edges.push_back(T{1});
+    }
+
+    return edges;
+}
+
+template <typename T>
+auto firwin_impl(std::size_t numtaps,
+                 const std::vector<T> &edges,
+                 const std::vector<T> &window,
+                 bool scale) {
+    scicpp_require(numtaps > 0);
+    scicpp_require(window.size() == numtaps);
+
+    const auto pass_nyquist = !(std::abs(edges.back() - T{1}) > 0);
+    // A filter with a zero at the Nyquist frequency cannot pass it
+    scicpp_require(!pass_nyquist || numtaps % 2 == 1);
+
+    const auto alpha = T(numtaps - 1) / T{2};
+    std::vector<T> h(numtaps, T{0});
+
+    for (std::size_t i = 0; i < numtaps; ++i) {
+        const auto m = T(i) - alpha;
+
+        for (std::size_t b = 0; b < edges.size(); b += 2) {
+            const auto left = edges[b];
+            const auto right = edges[b + 1];
+            h[i] += right * units::sinc(right * m);
+            h[i] -= left * units::sinc(left * m);
+        }
+
+        h[i] *= window[i];
+    }
+
+    if (scale) {
+        // Unit gain at the center of the first pass band
+        // (at DC or at Nyquist if the band touches it).
+        const auto left = edges[0];
+        const auto right = edges[1];
+        T f{0};
+
+        if (left > T{0}) {
+            f = std::abs(right - T{1}) > 0 ? (left + right) / T{2} : T{1};
+        }
+
+        T s{0};
+
+        for (std::size_t i = 0; i < numtaps; ++i) {
+            s += h[i] * std::cos(pi<T> * (T(i) - alpha) * f);
+        }
+
+        for (auto &v : h) {
+            v /= s;
+        }
+    }
+
+    return h;
+}
+
+} // namespace detail
+
+// Filter of numtaps coefficients with the given window
+// (for instance windows::kaiser(numtaps, beta)).
+// cutoff is either a single frequency or an array of increasing band edges,
+// pass_zero selects whether the first band (starting at DC) is a pass band.
+template <class Cutoff, typename T = meta::value_type_t<Cutoff>>
+auto firwin(std::size_t numtaps,
+            const Cutoff &cutoff,
+            const std::vector<T> &window,
+            bool pass_zero = true,
+            bool scale = true,
+            T fs = T{2}) {
+    static_assert(std::is_floating_point_v<T>);
+    const auto edges = detail::firwin_band_edges(cutoff, pass_zero, fs);
+
+    return detail::cached_design<T>(
+        detail::FIRWIN,
+        [&]() { return detail::firwin_impl(numtaps, edges, window, scale); },
+        numtaps,
+        edges,
+        window,
+        scale);
+}
+
+template <windows::Window win = windows::Hamming,
+          class Cutoff,
+          typename T = meta::value_type_t<Cutoff>>
+auto firwin(std::size_t numtaps,
+            const Cutoff &cutoff,
+            bool pass_zero = true,
+            bool scale = true,
+            T fs = T{2}) {
+    return firwin(numtaps,
+                  cutoff,
+                  windows::get_window<T>(win, numtaps),
+                  pass_zero,
+                  scale,
+                  fs);
+}
+
+//---------------------------------------------------------------------------------
+// firwin2
+//
+// FIR filter design using the frequency sampling method: the desired
+// gain, linearly interpolated on a uniform frequency grid, is inverse
+// Fourier transformed and the impulse response is multiplied by the window.
+//---------------------------------------------------------------------------------
+
+namespace detail {
+
+template <typename T>
+auto firwin2_impl(std::size_t numtaps,
+                  std::vector<T> freq,
+                  const std::vector<T> &gain,
+                  std::size_t nfreqs,
+                  bool antisymmetric,
+                  const std::vector<T> &window) {
+    const auto ftype = 1 + int(numtaps % 2 == 0) + 2 * int(antisymmetric);
+    // Types II and III have a zero at the Nyquist frequency,
+    // types III and IV at DC.
+    scicpp_require(ftype == 1 || ftype == 4 || !(std::abs(gain.back()) > 0));
+    scicpp_require(ftype <= 2 || !(std::abs(gain.front()) > 0));
+
+    // Repeated frequencies (steps in the gain) are moved apart
+    const auto eps = std::numeric_limits<T>::epsilon();
+
+    for (std::size_t k = 0; k + 1 < freq.size(); ++k) {
+        if (!(std::abs(freq[k + 1] - freq[k]) > 0)) {
+            freq[k] -= eps;
+            freq[k + 1] += eps;
+        }
+    }
+
+    // Desired gain on nfreqs frequencies in [0, 1], with the phase of a
+    // delay of (numtaps - 1) / 2 samples
+    std::vector<std::complex<T>> fx(nfreqs);
+    std::size_t j = 0;
+
+    for (std::size_t i = 0; i < nfreqs; ++i) {
+        const auto f = T(i) / T(nfreqs - 1);
+
+        while (j + 2 < freq.size() && f > freq[j + 1]) {
+            ++j;
+        }
+
+        const auto t =
+            std::clamp((f - freq[j]) / (freq[j + 1] - freq[j]), T{0}, T{1});
+        const auto g = gain[j] + t * (gain[j + 1] - gain[j]);
+        const auto phi = -T(numtaps - 1) / T{2} * pi<T> * f;
+        fx[i] = g * std::polar(T{1}, phi);
+
+        if (antisymmetric) {
+            fx[i] *= std::complex<T>(0, 1);
+        }
+    }
+
+    auto h = irfft(fx, int(2 * (nfreqs - 1)));
+    h.resize(numtaps);
+
+    for (std::size_t i = 0; i < numtaps; ++i) {
+        h[i] *= window[i];
+    }
+
+    if (ftype == 3) {
+        h[numtaps / 2] = T{0};
+    }
+
+    return h;
+}
+
+} // namespace detail
+
+// freq: increasing frequencies from 0 to fs / 2, where a frequency can be
+// repeated once for a step in the gain,
+// gain: desired gain at each frequency,
+// nfreqs: size of the interpolation grid (0 selects 1 + 2^ceil(log2(numtaps))),
+// antisymmetric: odd impulse response (types III and IV).
+template <windows::Window win = windows::Hamming,
+          class ArrayF,
+          class ArrayG,
+          typename T = typename ArrayF::value_type>
+auto firwin2(std::size_t numtaps,
+             const ArrayF &freq,
+             const ArrayG &gain,
+             std::size_t nfreqs = 0,
+             bool antisymmetric = false,
+             T fs = T{2}) {
+    static_assert(meta::is_iterable_v<ArrayF>);
+    static_assert(meta::is_iterable_v<ArrayG>);
+    static_assert(std::is_floating_point_v<T>);
+    scicpp_require(numtaps > 0);
+    scicpp_require(freq.size() >= 2 && freq.size() == gain.size());
+
+    const auto nyq = fs / T{2};
+    std::vector<T> f(freq.size());
+    std::transform(freq.cbegin(), freq.cend(), f.begin(), [=](auto v) {
+        return T(v) / nyq;
+    });
+    const std::vector<T> g(gain.cbegin(), gain.cend());
+
+    scicpp_require(!(std::abs(f.front()) > 0));
+    scicpp_require(!(std::abs(f.back() - T{1}) > 0));
+    scicpp_require(std::is_sorted(f.cbegin(), f.cend()));
+
+    if (nfreqs == 0) {
+        nfreqs = 2;
+
+        while (nfreqs - 1 < numtaps) {
+            nfreqs = 2 * nfreqs - 1;
+        }
+    }
+
+    scicpp_require(numtaps < nfreqs);
+
+    return detail::cached_design<T>(
+        detail::FIRWIN2,
+        [&]() {
+            return detail::firwin2_impl(numtaps,
+                                        f,
+                                        g,
+                                        nfreqs,
+                                        antisymmetric,
+                                        windows::get_window<T>(win, numtaps));
+        },
+        numtaps,
+        f,
+        g,
+        nfreqs,
+        antisymmetric,
+        win);
+}
+
+//---------------------------------------------------------------------------------
+// Kaiser window design
+//---------------------------------------------------------------------------------
+
+// Kaiser window parameter beta for an attenuation a (dB)
+template <typename T>
+auto kaiser_beta(T a) {
+    static_assert(std::is_floating_point_v<T>);
+
+    if (a > T{50}) {
+        return T{0.1102} * (a - T{8.7});
+    } else if (a > T{21}) {
+        return T{0.5842} * std::pow(a - T{21}, T{0.4}) +
+               T{0.07886} * (a - T{21});
+    } else {
+        return T{0};
+    }
+}
+
+// Attenuation (dB) of a Kaiser FIR filter of numtaps coefficients,
+// with a transition band of width normalized to the Nyquist frequency.
+template <typename T>
+auto kaiser_atten(std::size_t numtaps, T width) {
+    static_assert(std::is_floating_point_v<T>);
+    return T{2.285} * T(numtaps - 1) * pi<T> * width + T{7.95};
+}
+
+// Shortest Kaiser window filter meeting a specification:
+// ripple: maximum deviation (dB) in the pass and stop bands,
+// width: transition band width, normalized to the Nyquist frequency.
+// Returns {numtaps, beta}.
+template <typename T>
+scicpp_pure auto kaiserord(T ripple, T width) {
+    static_assert(std::is_floating_point_v<T>);
+    const auto a = std::abs(ripple);
+    // The empirical formula is only valid above 8 dB
+    scicpp_require(a >= T{8});
+    scicpp_require(width > T{0});
+
+    const auto numtaps = (a - T{7.95}) / T{2.285} / (pi<T> * width) + T{1};
+    return std::tuple{std::size_t(std::ceil(numtaps)), kaiser_beta(a)};
+}
+
+//---------------------------------------------------------------------------------
+// remez
+//
+// Minimax optimal (equiripple) linear phase FIR filter design with the
+// Parks-McClellan algorithm (Remez exchange on a dense frequency grid),
+// following the implementation of scipy.signal.remez (type 'bandpass').
+//---------------------------------------------------------------------------------
+
+namespace detail {
+
+// Amplitude response at the frequency f, by barycentric Lagrange
+// interpolation of the values y at the points x = cos(2 pi f_i)
+template <typename T>
+scicpp_pure T remez_response(T f,
+                             const std::vector<T> &ad,
+                             const std::vector<T> &x,
+                             const std::vector<T> &y) {
+    const auto xc = std::cos(T{2} * pi<T> * f);
+    T numer{0};
+    T denom{0};
+
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        auto c = xc - x[i];
+
+        if (std::abs(c) < T{1E-7}) {
+            return y[i];
+        }
+
+        c = ad[i] / c;
+        denom += c;
+        numer += c * y[i];
+    }
+
+    return numer / denom;
+}
+
+// Barycentric weights ad, interpolation points x and values y of the
+// alternating response on the extremal frequencies
+template <typename T>
+void remez_parameters(const std::vector<std::size_t> &ext,
+                      const std::vector<T> &grid,
+                      const std::vector<T> &D,
+                      const std::vector<T> &W,
+                      std::vector<T> &ad,
+                      std::vector<T> &x,
+                      std::vector<T> &y) {
+    const auto n = ext.size();
+
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = std::cos(T{2} * pi<T> * grid[ext[i]]);
+    }
+
+    // The products are interleaved (stride ld) to avoid overflows
+    const auto ld = (n - 2) / 15 + 1;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        T denom{1};
+
+        for (std::size_t j = 0; j < ld; ++j) {
+            for (auto k = j; k < n; k += ld) {
+                if (k != i) {
+                    denom *= T{2} * (x[i] - x[k]);
+                }
+            }
+        }
+
+        if (std::abs(denom) < T{1E-5}) {
+            denom = T{1E-5};
+        }
+
+        ad[i] = T{1} / denom;
+    }
+
+    // Deviation
+    T numer{0};
+    T denom{0};
+    T sign{1};
+
+    for (std::size_t i = 0; i < n; ++i) {
+        numer += ad[i] * D[ext[i]];
+        denom += sign * ad[i] / W[ext[i]];
+        sign = -sign;
+    }
+
+    const auto delta = numer / denom;
+    sign = T{1};
+
+    for (std::size_t i = 0; i < n; ++i) {
+        y[i] = D[ext[i]] - sign * delta / W[ext[i]];
+        sign = -sign;
+    }
+}
+
+// Search the local extrema of the error E, keeping ext.size() alternating
+// extrema. Returns false if there are not enough extrema.
+template <typename T>
+bool remez_search(std::vector<std::size_t> &ext, const std::vector<T> &E) {
+    const auto last = E.size() - 1;
+    std::vector<std::size_t> found;
+
+    // The grid edges are extrema if they are larger than their neighbor
+    if ((E[0] > T{0} && E[0] > E[1]) || (E[0] < T{0} && E[0] < E[1])) {
+        found.push_back(0);
+    }
+
+    for (std::size_t i = 1; i < last; ++i) {
+        if ((E[i] >= E[i - 1] && E[i] > E[i + 1] && E[i] > T{0}) ||
+            (E[i] <= E[i - 1] && E[i] < E[i + 1] && E[i] < T{0})) {
+            found.push_back(i);
+        }
+    }
+
+    if ((E[last] > T{0} && E[last] > E[last - 1]) ||
+        (E[last] < T{0} && E[last] < E[last - 1])) {
+        found.push_back(last);
+    }
+
+    if (found.size() < ext.size()) {
+        return false;
+    }
+
+    // Remove the extra extrema: the smallest one before the first
+    // non-alternating pair, or the smallest of the first and last
+    // extrema if a single alternating extra extremum remains.
+    while (found.size() > ext.size()) {
+        bool up = E[found[0]] > T{0};
+        bool alternating = true;
+        std::size_t l = 0;
+
+        for (std::size_t j = 1; j < found.size(); ++j) {
+            if (std::abs(E[found[j]]) < std::abs(E[found[l]])) {
+                l = j;
+            }
+
+            if (up && E[found[j]] < T{0}) {
+                up = false;
+            } else if (!up && E[found[j]] > T{0}) {
+                up = true;
+            } else {
+                alternating = false;
+                break;
+            }
+        }
+
+        if (alternating && found.size() == ext.size() + 1) {
+            l = std::abs(E[found.back()]) < std::abs(E[found.front()])
+                    ? found.size() - 1
+                    : 0;
+        }
+
+        found.erase(found.begin() + signed_size_t(l));
+    }
+
+    std::copy(found.cbegin(), found.cend(), ext.begin());
+    return true;
+}
+
+template <typename T>
+auto remez_impl(std::size_t numtaps,
+                const std::vector<T> &bands,
+                const std::vector<T> &desired,
+                const std::vector<T> &weight,
+                std::size_t maxiter,
+                std::size_t grid_density) {
+    // Number of cosine functions of the amplitude response
+    const auto r = numtaps / 2 + numtaps % 2;
+    const auto delf = T{0.5} / T(grid_density * r);
+
+    // Dense frequency grid (in cycles per sample) of the bands,
+    // desired response D and weight W
+    std::vector<T> grid, D, W;
+
+    for (std::size_t b = 0; b < desired.size(); ++b) {
+        auto f = bands[2 * b];
+        const auto k = std::max(
+            std::size_t((bands[2 * b + 1] - f) / delf + T{0.5}),
+            std::size_t(1));
+
+        for (std::size_t i = 0; i < k; ++i) {
+            grid.push_back(f);
+            D.push_back(desired[b]);
+            W.push_back(weight[b]);
+            f += delf;
+        }
+
+        grid.back() = bands[2 * b + 1];
+    }
+
+    // An even number of taps has a cos(pi f) factor in the response
+    if (numtaps % 2 == 0) {
+        for (std::size_t i = 0; i < grid.size(); ++i) {
+            const auto c = std::cos(pi<T> * grid[i]);
+            D[i] /= c;
+            W[i] *= c;
+        }
+    }
+
+    const auto ngrid = grid.size();
+    scicpp_require(ngrid > r);
+
+    std::vector<std::size_t> ext(r + 1);
+
+    for (std::size_t i = 0; i <= r; ++i) {
+        ext[i] = i * (ngrid - 1) / r;
+    }
+
+    std::vector<T> ad(r + 1), x(r + 1), y(r + 1), E(ngrid);
+
+    for (std::size_t iter = 0; iter < maxiter; ++iter) {
+        remez_parameters(ext, grid, D, W, ad, x, y);
+
+        for (std::size_t i = 0; i < ngrid; ++i) {
+            E[i] = W[i] * (D[i] - remez_response(grid[i], ad, x, y));
+        }
+
+        if (!remez_search(ext, E)) {
+            break;
+        }
+
+        // Converged when the extrema have the same magnitude
+        const auto [emin, emax] =
+            std::minmax_element(ext.cbegin(), ext.cend(), [&](auto i, auto j) {
+                return std::abs(E[i]) < std::abs(E[j]);
+            });
+
+        if ((std::abs(E[*emax]) - std::abs(E[*emin])) / std::abs(E[*emax]) <
+            T{1E-4}) {
+            break;
+        }
+    }
+
+    remez_parameters(ext, grid, D, W, ad, x, y);
+
+    // Amplitude response sampled at the frequencies i / numtaps
+    std::vector<T> A(numtaps / 2 + 1);
+
+    for (std::size_t i = 0; i < A.size(); ++i) {
+        const auto f = T(i) / T(numtaps);
+        const auto c = numtaps % 2 == 1 ? T{1} : std::cos(pi<T> * f);
+        A[i] = remez_response(f, ad, x, y) * c;
+    }
+
+    // Impulse response by frequency sampling
+    const auto M = T(numtaps - 1) / T{2};
+    const auto kmax = numtaps % 2 == 1 ? (numtaps - 1) / 2 : numtaps / 2 - 1;
+    std::vector<T> h(numtaps);
+
+    for (std::size_t n = 0; n < numtaps; ++n) {
+        const auto w = T{2} * pi<T> * (T(n) - M) / T(numtaps);
+        auto v = A[0];
+
+        for (std::size_t k = 1; k <= kmax; ++k) {
+            v += T{2} * A[k] * std::cos(w * T(k));
+        }
+
+        h[n] = v / T(numtaps);
+    }
+
+    return h;
+}
+
+} // namespace detail
+
+// bands: increasing band edges (pairs of frequencies from 0 to fs / 2),
+// desired: gain in each band,
+// weight: relative weight of the error in each band.
+// The last iteration is returned if the algorithm does not converge
+// in maxiter iterations.
+template <class ArrayB,
+          class ArrayD,
+          class ArrayW,
+          typename T = typename ArrayB::value_type,
+          meta::enable_if_iterable<ArrayW> = 0>
+auto remez(std::size_t numtaps,
+           const ArrayB &bands,
+           const ArrayD &desired,
+           const ArrayW &weight,
+           T fs = T{1},
+           std::size_t maxiter = 25,
+           std::size_t grid_density = 16) {
+    static_assert(meta::is_iterable_v<ArrayB>);
+    static_assert(meta::is_iterable_v<ArrayD>);
+    static_assert(meta::is_iterable_v<ArrayW>);
+    static_assert(std::is_floating_point_v<T>);
+    scicpp_require(numtaps > 0);
+    scicpp_require(!desired.empty());
+    scicpp_require(bands.size() == 2 * desired.size());
+    scicpp_require(weight.size() == desired.size());
+
+    std::vector<T> b(bands.size());
+    std::transform(bands.cbegin(), bands.cend(), b.begin(), [=](auto v) {
+        return T(v) / fs;
+    });
+
+    scicpp_require(std::is_sorted(b.cbegin(), b.cend()));
+    scicpp_require(b.front() >= T{0} && b.back() <= T{0.5});
+
+    const std::vector<T> d(desired.cbegin(), desired.cend());
+    const std::vector<T> w(weight.cbegin(), weight.cend());
+
+    return detail::cached_design<T>(
+        detail::REMEZ,
+        [&]() {
+            return detail::remez_impl(numtaps, b, d, w, maxiter, grid_density);
+        },
+        numtaps,
+        b,
+        d,
+        w,
+        maxiter,
+        grid_density);
+}
+
+template <class ArrayB,
+          class ArrayD,
+          typename T = typename ArrayB::value_type,
+          meta::disable_if_iterable<T> = 0>
+auto remez(std::size_t numtaps,
+           const ArrayB &bands,
+           const ArrayD &desired,
+           T fs = T{1}) {
+    return remez(
+        numtaps, bands, desired, std::vector<T>(desired.size(), T{1}), fs);
+}
+
+} // namespace scicpp::signal
+
+#endif // SCICPP_SIGNAL_FIR_FILTER_DESIGN
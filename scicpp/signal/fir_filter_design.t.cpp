@@ -0,0 +1,289 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#include "fir_filter_design.hpp"
+
+#include "scicpp/core/equal.hpp"
+
+#include <cmath>
+#include <tuple>
+#include <vector>
+
+namespace scicpp::signal {
+
+namespace {
+
+auto max_deviation(const std::vector<double> &x,
+                   const std::vector<double> &y) {
+    REQUIRE(x.size() == y.size());
+    double res = 0.0;
+
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        res = std::max(res, std::abs(x[i] - y[i]));
+    }
+
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("firwin") {
+    SECTION("Low-pass") {
+        REQUIRE(almost_equal<4>(firwin(11, 0.3),
+                                {-0.005215537578805756, -0.008040161696770624,
+                                 0.013358630903322724, 0.10573868864477395,
+                                 0.2405481183953142, 0.30722052266433086,
+                                 0.2405481183953142, 0.10573868864477395,
+                                 0.013358630903322724, -0.008040161696770624,
+                                 -0.005215537578805756}));
+        REQUIRE(almost_equal<4>(firwin(11, 100., true, true, 1000.),
+                                {7.391423150963729e-19, 0.009304283145018147,
+                                 0.04757776613441745, 0.12236354636114467,
+                                 0.20224655842984032, 0.23701569185915894,
+                                 0.20224655842984032, 0.12236354636114467,
+                                 0.04757776613441745, 0.009304283145018147,
+                                 7.391423150963729e-19}));
+        REQUIRE(almost_equal<4>(firwin(9, 0.3, true, false),
+                                {-0.0037419571351545587, 0.0070405362986213065,
+                                 0.08173728669319096, 0.22282246600580757, 0.3,
+                                 0.22282246600580757, 0.08173728669319096,
+                                 0.0070405362986213065,
+                                 -0.0037419571351545587}));
+    }
+
+    SECTION("High-pass") {
+        REQUIRE(almost_equal<4>(firwin(11, 0.3, false),
+                                {0.005119127736867044, 0.007891538336928032,
+                                 -0.013111694997973159, -0.1037840962168571,
+                                 -0.2361015573797461, 0.7035968664781536,
+                                 -0.2361015573797461, -0.1037840962168571,
+                                 -0.013111694997973159, 0.007891538336928032,
+                                 0.005119127736867044}));
+    }
+
+    SECTION("Band-pass and band-stop") {
+        REQUIRE(almost_equal<4>(firwin(11, std::array{0.2, 0.5}, false),
+                                {0.007226086510412356, -0.011139581126720933,
+                                 -0.11685667205781718, -0.14650012584506206,
+                                 0.16981338636235882, 0.42565163053717026,
+                                 0.16981338636235882, -0.14650012584506206,
+                                 -0.11685667205781718, -0.011139581126720933,
+                                 0.007226086510412356}));
+        REQUIRE(almost_equal<4>(firwin(11, std::vector{0.2, 0.5}),
+                                {-0.006082047581050116, 0.009375955068910228,
+                                 0.0983558442864887, 0.12330612631548074,
+                                 -0.1429284155769367, 0.8359450749742142,
+                                 -0.1429284155769367, 0.12330612631548074,
+                                 0.0983558442864887, 0.009375955068910228,
+                                 -0.006082047581050116}));
+    }
+
+    SECTION("Windows") {
+        REQUIRE(almost_equal<16>(firwin<windows::Hann>(12, 0.3),
+                                 {-0.0, -0.005014082337705843,
+                                  -0.004168032309771919, 0.05154064316051119,
+                                  0.17382376053640372, 0.28381771095056285,
+                                  0.28381771095056285, 0.17382376053640372,
+                                  0.05154064316051119, -0.004168032309771921,
+                                  -0.005014082337705836, -0.0}));
+        REQUIRE(almost_equal<16>(firwin(9, 0.3, windows::kaiser(9, 5.0)),
+                                 {-0.0018541357950408411, 0.00816212923205179,
+                                  0.09035931667414923, 0.24136475842545596,
+                                  0.3239358629267677, 0.24136475842545596,
+                                  0.09035931667414923, 0.00816212923205179,
+                                  -0.0018541357950408411}));
+    }
+}
+
+TEST_CASE("firwin2") {
+    SECTION("Type I") {
+        REQUIRE(max_deviation(firwin2(11,
+                                      std::vector{0., 0.5, 1.},
+                                      std::vector{1., 1., 0.}),
+                              {7.031482209736526e-04,
+                               0.0,
+                               9.221542236183858e-03,
+                               -7.001112840413344e-02,
+                               1.854347857549024e-01,
+                               0.75,
+                               1.854347857549024e-01,
+                               -7.001112840413344e-02,
+                               9.221542236183858e-03,
+                               0.0,
+                               7.031482209736526e-04}) < 1E-15);
+        REQUIRE(max_deviation(firwin2(11,
+                                      std::array{0., 100., 250., 500.},
+                                      std::array{1., 1., 0.5, 0.},
+                                      65,
+                                      false,
+                                      1000.),
+                              {-2.1462974841999152e-04,
+                               -3.2107984409059818e-03,
+                               2.1797524225914593e-03,
+                               3.1347523550413177e-03,
+                               2.1705473151924137e-01,
+                               5.4996744791666663e-01,
+                               2.1705473151924137e-01,
+                               3.1347523550413177e-03,
+                               2.1797524225914593e-03,
+                               -3.2107984409059818e-03,
+                               -2.1462974841999152e-04}) < 1E-15);
+    }
+
+    SECTION("Type II") {
+        REQUIRE(max_deviation(firwin2(10,
+                                      std::array{0., 0.3, 0.3, 1.},
+                                      std::array{1., 1., 0., 0.}),
+                              {-0.00433248917356063,
+                               0.00085395634384228,
+                               0.04753131073886601,
+                               0.15907654573211794,
+                               0.2647454030563822,
+                               0.2647454030563822,
+                               0.15907654573211794,
+                               0.04753131073886601,
+                               0.00085395634384228,
+                               -0.00433248917356063}) < 1E-15);
+    }
+
+    SECTION("Type III") {
+        REQUIRE(max_deviation(firwin2(9,
+                                      std::vector{0., 0.5, 1.},
+                                      std::vector{0., 1., 0.},
+                                      0,
+                                      true),
+                              {0.0,
+                               -9.9541989313075216e-03,
+                               0.0,
+                               3.5180919299106805e-01,
+                               0.0,
+                               -3.5180919299106805e-01,
+                               0.0,
+                               9.9541989313075216e-03,
+                               0.0}) < 1E-15);
+    }
+
+    SECTION("Type IV") {
+        REQUIRE(max_deviation(firwin2<windows::Hann>(8,
+                                                     std::vector{0., 0.5, 1.},
+                                                     std::vector{0., 1., 1.},
+                                                     0,
+                                                     true),
+                              {0.0,
+                               -0.00468003000121888,
+                               0.04007311633609541,
+                               0.5465324914012734,
+                               -0.5465324914012736,
+                               -0.04007311633609526,
+                               0.00468003000121885,
+                               0.0}) < 1E-15);
+    }
+}
+
+TEST_CASE("kaiserord") {
+    REQUIRE(almost_equal(kaiser_beta(30.), 2.1166248611409806));
+    REQUIRE(almost_equal(kaiser_beta(60.), 0.1102 * (60. - 8.7)));
+    REQUIRE(almost_equal(kaiser_beta(10.), 0.));
+    REQUIRE(almost_equal<2>(kaiser_atten(211, 0.0625), 102.1683271765664));
+
+    const auto [numtaps, beta] = kaiserord(65., 0.05);
+    REQUIRE(numtaps == 160);
+    REQUIRE(almost_equal<2>(beta, 0.1102 * (65. - 8.7)));
+    // The shortest filter meeting the specification
+    REQUIRE(kaiser_atten(numtaps, 0.05) >= 65.);
+    REQUIRE(kaiser_atten(numtaps - 1, 0.05) < 65.);
+}
+
+TEST_CASE("remez") {
+    SECTION("Low-pass") {
+        REQUIRE(max_deviation(remez(11,
+                                    std::vector{0., 0.1, 0.2, 0.5},
+                                    std::vector{1., 0.}),
+                              {-0.05050399753520547,
+                               -0.03069665790696422,
+                               0.03275526742496901,
+                               0.14641971643381654,
+                               0.2585277223282103,
+                               0.30544025095809957,
+                               0.2585277223282103,
+                               0.14641971643381654,
+                               0.03275526742496901,
+                               -0.03069665790696422,
+                               -0.05050399753520547}) < 1E-12);
+        REQUIRE(max_deviation(remez(12,
+                                    std::vector{0., 0.1, 0.2, 0.5},
+                                    std::vector{1., 0.}),
+                              {-0.03149135806860533,
+                               -0.05508018562701147,
+                               -0.004562953574916,
+                               0.07788377927143214,
+                               0.20435333169431366,
+                               0.2866516121292213,
+                               0.2866516121292213,
+                               0.20435333169431366,
+                               0.07788377927143214,
+                               -0.004562953574916,
+                               -0.05508018562701147,
+                               -0.03149135806860533}) < 1E-12);
+        REQUIRE(max_deviation(remez(21,
+                                    std::array{0., 100., 150., 500.},
+                                    std::array{1., 0.},
+                                    1000.),
+                              {0.0378466173790635,   0.01405677829596364,
+                               -0.00345667484944756, -0.02941508360154754,
+                               -0.04881473921260703, -0.0436803141695293,
+                               -0.0030485699616474,  0.06935577791234224,
+                               0.15377835382667535,  0.2214703712101877,
+                               0.24734224570535931,  0.2214703712101877,
+                               0.15377835382667535,  0.06935577791234224,
+                               -0.0030485699616474,  -0.0436803141695293,
+                               -0.04881473921260703, -0.02941508360154754,
+                               -0.00345667484944756, 0.01405677829596364,
+                               0.0378466173790635}) < 1E-12);
+    }
+
+    SECTION("Weighted band-pass") {
+        REQUIRE(max_deviation(remez(15,
+                                    std::vector{0., 0.1, 0.15, 0.3, 0.35, 0.5},
+                                    std::vector{0., 1., 0.},
+                                    std::vector{10., 1., 10.}),
+                              {-0.00216307753599415, -0.01690082800808455,
+                               0.06258363929039863,  0.139056420954678,
+                               -0.11420270780629582, -0.295403170239575,
+                               0.05390290516860306,  0.38689387156501437,
+                               0.05390290516860306,  -0.295403170239575,
+                               -0.11420270780629582, 0.139056420954678,
+                               0.06258363929039863,  -0.01690082800808455,
+                               -0.00216307753599415}) < 1E-12);
+    }
+}
+
+TEST_CASE("FIR design cache") {
+    clear_fir_design_cache();
+    REQUIRE(fir_design_cache_size() == 0);
+
+    const auto h1 = firwin(31, 0.2);
+    REQUIRE(fir_design_cache_size() == 1);
+    // Same design: read from the cache
+    REQUIRE(firwin(31, 0.2) == h1);
+    REQUIRE(firwin(31, 20., true, true, 200.) == h1);
+    REQUIRE(fir_design_cache_size() == 1);
+
+    // Different parameters
+    REQUIRE(firwin(31, 0.2, true, false) != h1);
+    REQUIRE(firwin(33, 0.2).size() == 33);
+    REQUIRE(firwin<windows::Hann>(31, 0.2) != h1);
+    REQUIRE(fir_design_cache_size() == 4);
+
+    std::ignore =
+        remez(11, std::vector{0., 0.1, 0.2, 0.5}, std::vector{1., 0.});
+    std::ignore =
+        firwin2(11, std::vector{0., 0.5, 1.}, std::vector{1., 1., 0.});
+    REQUIRE(fir_design_cache_size() == 6);
+    REQUIRE(fir_design_cache_size<float>() == 0);
+
+    clear_fir_design_cache();
+    REQUIRE(fir_design_cache_size() == 0);
+}
+
+} // namespace scicpp::signal
@@ -0,0 +1,304 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#ifndef SCICPP_SIGNAL_GOERTZEL
+#define SCICPP_SIGNAL_GOERTZEL
+
+#include "scicpp/core/constants.hpp"
+#include "scicpp/core/macros.hpp"
+#include "scicpp/core/meta.hpp"
+#include "scicpp/core/units/quantity.hpp"
+#include "scicpp/signal/mixed_radix_fft.hpp"
+#include "scicpp/signal/spectral.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace scicpp::signal {
+
+//---------------------------------------------------------------------------------
+// Goertzel
+//
+// DFT of a block of n samples at a few arbitrary frequencies,
+// X(f) = sum_{j < n} x[j] exp(-2 i pi f j / fs),
+// in O(n) operations per frequency: a real second-order recursion
+// per frequency, and a single complex rotation at the end of the block.
+// The recursion uses Reinsch's modification, which remains accurate
+// for frequencies close to 0 or fs / 2.
+//
+// Compared to an FFT of the whole block, this is faster for less than
+// ~ log2(n) frequencies, which needs not be on the FFT grid.
+//
+// EltTp is the element type of the signal: T or std::complex<T>.
+//---------------------------------------------------------------------------------
+
+namespace detail {
+
+// exp(-2 i pi f k / fs), with the phase reduced to one turn in long double
+template <typename T>
+std::complex<T> dft_twiddle(T f, T fs, long double k) {
+    const auto turns = static_cast<long double>(f) * k /
+                       static_cast<long double>(fs);
+    const auto phase = turns - std::floor(turns);
+    return std::polar(T{1}, T(-2 * pi<long double> * phase));
+}
+
+// Goertzel recursion s[j] = x[j] + 2 cos(w) s[j - 1] - s[j - 2], written
+// with d[j] = s[j] - sign s[j - 1] (Reinsch's modification) to be accurate
+// near w = 0 (sign = 1) and w = pi (sign = -1):
+// d[j] = x[j] + lambda s[j - 1] + sign d[j - 1], s[j] = sign s[j - 1] + d[j],
+// with lambda = 2 cos(w) - 2 sign.
+template <typename T, typename EltTp, class InputIt>
+scicpp_target_clones void goertzel_recursion(InputIt first,
+                                             InputIt last,
+                                             const T *lambdas,
+                                             const T *signs,
+                                             EltTp *s,
+                                             EltTp *d,
+                                             std::size_t nfreqs) {
+    for (; first != last; ++first) {
+        const auto v = EltTp(units::value(*first));
+
+        for (std::size_t k = 0; k < nfreqs; ++k) {
+            d[k] = v + lambdas[k] * s[k] + signs[k] * d[k];
+            s[k] = signs[k] * s[k] + d[k];
+        }
+    }
+}
+
+} // namespace detail
+
+template <typename T = double, typename EltTp = T>
+class Goertzel {
+  public:
+    static_assert(std::is_same_v<EltTp, T> ||
+                  std::is_same_v<EltTp, std::complex<T>>);
+
+    // DFT at the frequencies freqs, for the sampling frequency fs
+    explicit Goertzel(std::vector<T> freqs, T fs = T{2})
+        : m_freqs(std::move(freqs)), m_fs(fs) {
+        scicpp_require(m_fs > T{0});
+
+        const auto nfreqs = m_freqs.size();
+        m_lambdas.resize(nfreqs);
+        m_signs.resize(nfreqs);
+        m_rot.resize(nfreqs);
+        m_gains.resize(nfreqs);
+
+        for (std::size_t k = 0; k < nfreqs; ++k) {
+            // Half angle w / 2 in [0, pi)
+            const auto turns = static_cast<long double>(m_freqs[k]) /
+                               static_cast<long double>(m_fs);
+            const auto half = pi<long double> * (turns - std::floor(turns));
+            const auto sin_half = std::sin(half);
+            const auto cos_half = std::cos(half);
+            const auto sin_w = 2 * sin_half * cos_half;
+
+            m_rot[k] = detail::dft_twiddle(m_freqs[k], m_fs, 1.0L);
+
+            // 1 - sign exp(-i w)
+            if (cos_half >= sin_half) {
+                m_signs[k] = T{1};
+                m_lambdas[k] = T(-4 * sin_half * sin_half);
+                m_gains[k] = {T(2 * sin_half * sin_half), T(sin_w)};
+            } else {
+                m_signs[k] = T{-1};
+                m_lambdas[k] = T(4 * cos_half * cos_half);
+                m_gains[k] = {T(2 * cos_half * cos_half), T(-sin_w)};
+            }
+        }
+    }
+
+    // DFT of the block x at each frequency, stored into dst
+    template <class Array>
+    void operator()(const Array &x, std::vector<std::complex<T>> &dst) {
+        static_assert(meta::is_iterable_v<Array>);
+        static_assert(std::is_same_v<detail::element_type_t<Array>, EltTp>);
+
+        const auto nfreqs = m_freqs.size();
+        m_s.assign(nfreqs, EltTp{0});
+        m_d.assign(nfreqs, EltTp{0});
+        detail::goertzel_recursion(x.cbegin(),
+                                   x.cend(),
+                                   m_lambdas.data(),
+                                   m_signs.data(),
+                                   m_s.data(),
+                                   m_d.data(),
+                                   nfreqs);
+
+        // X(f) = exp(-i w (n - 1)) (s[n - 1] - exp(-i w) s[n - 2])
+        //      = exp(-i w (n - 1)) ((1 - sign exp(-i w)) s[n - 1]
+        //                           + sign exp(-i w) d[n - 1])
+        const auto last = static_cast<long double>(x.size()) - 1;
+        dst.resize(nfreqs);
+
+        for (std::size_t k = 0; k < nfreqs; ++k) {
+            const auto y =
+                detail::complex_mul(std::complex<T>(m_s[k]), m_gains[k]) +
+                m_signs[k] *
+                    detail::complex_mul(std::complex<T>(m_d[k]), m_rot[k]);
+            dst[k] = detail::complex_mul(
+                y, detail::dft_twiddle(m_freqs[k], m_fs, last));
+        }
+    }
+
+    template <class Array>
+    auto operator()(const Array &x) {
+        std::vector<std::complex<T>> dst;
+        (*this)(x, dst);
+        return dst;
+    }
+
+    const auto &frequencies() const { return m_freqs; }
+    auto fs() const { return m_fs; }
+
+  private:
+    std::vector<T> m_freqs;
+    T m_fs;
+    std::vector<T> m_lambdas{};
+    std::vector<T> m_signs{};
+    std::vector<std::complex<T>> m_rot{};   // exp(-i w)
+    std::vector<std::complex<T>> m_gains{}; // 1 - sign exp(-i w)
+    std::vector<EltTp> m_s{};
+    std::vector<EltTp> m_d{};
+}; // class Goertzel
+
+// DFT of x at the frequencies freqs, for the sampling frequency fs
+template <class Array,
+          typename T = meta::value_type_t<detail::element_type_t<Array>>>
+auto goertzel(const Array &x, const std::vector<T> &freqs, T fs = T{2}) {
+    return Goertzel<T, detail::element_type_t<Array>>(freqs, fs)(x);
+}
+
+//---------------------------------------------------------------------------------
+// SlidingDFT
+//
+// DFT of the last n samples at a few arbitrary frequencies, updated at each
+// new sample x[m] in O(1) operations per frequency:
+// X_m(f) = exp(i w) (X_{m-1}(f) - x[m - n]) + exp(-i w (n - 1)) x[m],
+// with w = 2 pi f / fs, the oldest sample of the window having index 0.
+//
+// The recursion is marginally stable and rounding errors accumulate.
+// The values are thus recomputed from the last n samples (Goertzel)
+// every reset_period samples, which costs O(1) per sample and frequency
+// for a reset period of the order of n or longer.
+//
+// Samples are pushed by blocks of any size, from the same buffers than
+// StreamingSpectrum. Until n samples have been pushed, the missing samples
+// are zeros.
+//
+// EltTp is the element type of the signal: T or std::complex<T>.
+//---------------------------------------------------------------------------------
+
+template <typename T = double, typename EltTp = T>
+class SlidingDFT {
+  public:
+    static_assert(std::is_same_v<EltTp, T> ||
+                  std::is_same_v<EltTp, std::complex<T>>);
+
+    // Default reset period, in number of windows
+    static constexpr std::size_t reset_windows = 16;
+
+    // Window of n samples, frequencies freqs, sampling frequency fs.
+    // Recompute the values every reset_period samples
+    // (reset_windows * n if 0).
+    SlidingDFT(std::size_t n,
+               std::vector<T> freqs,
+               T fs = T{2},
+               std::size_t reset_period = 0)
+        : m_goertzel(std::move(freqs), fs),
+          m_history(n, EltTp{0}),
+          m_reset_period(reset_period > 0 ? reset_period : reset_windows * n) {
+        scicpp_require(n > 0);
+
+        const auto &f = m_goertzel.frequencies();
+        m_rot.resize(f.size());
+        m_coefs.resize(f.size());
+        m_values.assign(f.size(), std::complex<T>{0});
+
+        for (std::size_t k = 0; k < f.size(); ++k) {
+            m_rot[k] = detail::dft_twiddle(f[k], fs, -1.0L);
+            m_coefs[k] = detail::dft_twiddle(
+                f[k], fs, static_cast<long double>(n) - 1);
+        }
+    }
+
+    // Push a new block of samples
+    template <typename Array>
+    void push(const Array &x) {
+        static_assert(meta::is_iterable_v<Array>);
+        static_assert(std::is_same_v<detail::element_type_t<Array>, EltTp>);
+
+        for (const auto &v : x) {
+            update(EltTp(units::value(v)));
+        }
+    }
+
+    // DFT of the last n samples at each frequency
+    const auto &values() const { return m_values; }
+
+    const auto &frequencies() const { return m_goertzel.frequencies(); }
+    auto fs() const { return m_goertzel.fs(); }
+    std::size_t size() const { return m_history.size(); }
+
+    // Discard the samples pushed so far
+    void reset() {
+        std::fill(m_history.begin(), m_history.end(), EltTp{0});
+        std::fill(m_values.begin(), m_values.end(), std::complex<T>{0});
+        m_pos = 0;
+        m_nupdates = 0;
+    }
+
+  private:
+    Goertzel<T, EltTp> m_goertzel;
+    std::vector<EltTp> m_history; // Ring buffer of the last n samples
+    std::size_t m_reset_period;
+    std::vector<std::complex<T>> m_rot{};
+    std::vector<std::complex<T>> m_coefs{};
+    std::vector<std::complex<T>> m_values{};
+    std::vector<EltTp> m_window{};
+    std::size_t m_pos = 0; // Position of the oldest sample
+    std::size_t m_nupdates = 0;
+
+    void update(EltTp v) {
+        const auto oldest = m_history[m_pos];
+        m_history[m_pos] = v;
+        m_pos = m_pos + 1 == m_history.size() ? 0 : m_pos + 1;
+
+        for (std::size_t k = 0; k < m_values.size(); ++k) {
+            auto &y = m_values[k];
+            y = detail::complex_mul(y - oldest, m_rot[k]);
+
+            if constexpr (meta::is_complex_v<EltTp>) {
+                y += detail::complex_mul(v, m_coefs[k]);
+            } else {
+                y += v * m_coefs[k];
+            }
+        }
+
+        if (unlikely(++m_nupdates == m_reset_period)) {
+            resync();
+        }
+    }
+
+    // Recompute the values from the samples of the window
+    void resync() {
+        const auto first = m_history.cbegin() + signed_size_t(m_pos);
+        m_window.resize(m_history.size());
+        std::copy(
+            m_history.cbegin(),
+            first,
+            std::copy(first, m_history.cend(), m_window.begin()));
+        m_goertzel(m_window, m_values);
+        m_nupdates = 0;
+    }
+}; // class SlidingDFT
+
+} // namespace scicpp::signal
+
+#endif // SCICPP_SIGNAL_GOERTZEL
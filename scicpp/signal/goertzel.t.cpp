@@ -0,0 +1,167 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#include "goertzel.hpp"
+
+#include "scicpp/core/constants.hpp"
+#include "scicpp/core/numeric.hpp"
+#include "scicpp/core/random.hpp"
+#include "scicpp/core/utils.hpp"
+#include "scicpp/signal/fft.hpp"
+
+#include <complex>
+#include <vector>
+
+namespace scicpp::signal {
+
+namespace {
+
+// Direct evaluation of sum_j x[j] exp(-2 i pi f j / fs)
+template <class Array, typename T>
+auto direct_dft(const Array &x, const std::vector<T> &freqs, T fs) {
+    using Cplx = std::complex<long double>;
+    std::vector<std::complex<T>> res(freqs.size());
+
+    for (std::size_t k = 0; k < freqs.size(); ++k) {
+        Cplx acc{0};
+
+        for (std::size_t j = 0; j < x.size(); ++j) {
+            const auto phase = -2 * pi<long double> *
+                               static_cast<long double>(freqs[k]) *
+                               static_cast<long double>(j) /
+                               static_cast<long double>(fs);
+            acc += Cplx(x[j]) * std::polar(1.0L, phase);
+        }
+
+        res[k] = std::complex<T>(acc);
+    }
+
+    return res;
+}
+
+// Largest distance between x and y, relative to the largest magnitude of y
+template <typename T>
+T dft_error(const std::vector<std::complex<T>> &x,
+            const std::vector<std::complex<T>> &y) {
+    REQUIRE(x.size() == y.size());
+    T err{0};
+    T norm{0};
+
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        err = std::max(err, std::abs(x[i] - y[i]));
+        norm = std::max(norm, std::abs(y[i]));
+    }
+
+    return err / norm;
+}
+
+} // namespace
+
+TEST_CASE("goertzel") {
+    using namespace operators;
+
+    SECTION("FFT bins") {
+        const auto x = random::randn<double>(1000);
+        const auto X = rfft(x);
+        const auto y = goertzel(x, {0.0, 10.0, 123.0, 500.0}, 1000.0);
+        REQUIRE(dft_error(y, std::vector{X[0], X[10], X[123], X[500]}) <
+                1E-13);
+    }
+
+    SECTION("Arbitrary frequencies") {
+        const std::vector freqs{0.01, 0.123456, 0.5, 0.999};
+        const auto x = random::randn<double>(4096);
+        REQUIRE(dft_error(goertzel(x, freqs), direct_dft(x, freqs, 2.0)) <
+                1E-11);
+    }
+
+    SECTION("Complex") {
+        const auto x = random::randn<double>(256) +
+                       1.0i * random::randn<double>(256);
+        const auto X = fft(x);
+        Goertzel<double, std::complex<double>> g({3.0, 250.0}, 256.0);
+        REQUIRE(dft_error(g(x), std::vector{X[3], X[250]}) < 1E-13);
+        REQUIRE(g.frequencies().size() == 2);
+    }
+
+    SECTION("Physical quantity") {
+        using namespace units::literals;
+        const auto x = random::randn<double>(100);
+        REQUIRE(dft_error(goertzel(x * 1_V, {7.0}, 100.0),
+                          goertzel(x, {7.0}, 100.0)) < 1E-15);
+    }
+
+    SECTION("Empty") {
+        REQUIRE(goertzel(empty<double>(), {1.0})[0] == 0.0);
+    }
+}
+
+TEST_CASE("SlidingDFT") {
+    using namespace operators;
+
+    const std::vector freqs{0.0, 50.0, 60.0, 137.5, 500.0};
+    const double fs = 1000.0;
+    const std::size_t n = 200;
+
+    SECTION("Block-wise") {
+        const auto x = random::randn<double>(5000);
+        SlidingDFT<double> sdft(n, freqs, fs);
+        REQUIRE(sdft.size() == n);
+        REQUIRE(sdft.frequencies() == freqs);
+
+        std::size_t i = 0;
+
+        for (std::size_t len : {17U, 183U, 1U, 200U, 999U, 3600U}) {
+            const auto start = signed_size_t(i);
+            sdft.push(utils::subvector(x, signed_size_t(len), start));
+            i += len;
+
+            const auto first = i < n ? 0 : i - n;
+            const auto window = utils::subvector(
+                x, signed_size_t(i - first), signed_size_t(first));
+            auto y = direct_dft(window, freqs, fs);
+
+            // Missing samples are zeros
+            if (i < n) {
+                for (std::size_t k = 0; k < freqs.size(); ++k) {
+                    const auto shift = double(n - i) * freqs[k] / fs;
+                    y[k] *= std::polar(1.0, -2.0 * pi<double> * shift);
+                }
+            }
+
+            REQUIRE(dft_error(sdft.values(), y) < 1E-12);
+        }
+
+        sdft.reset();
+        sdft.push(x);
+        const auto last = utils::subvector(x, signed_size_t(n), 4800);
+        REQUIRE(dft_error(sdft.values(), direct_dft(last, freqs, fs)) < 1E-12);
+    }
+
+    SECTION("Long run") {
+        // Reset more often than the default, and never
+        const auto x = random::randn<double>(200000);
+        SlidingDFT<double> sdft(n, freqs, fs, 997);
+        SlidingDFT<double> sdft_drift(n, freqs, fs, x.size() + 1);
+        sdft.push(x);
+        sdft_drift.push(x);
+
+        const auto y = direct_dft(
+            utils::subvector(x, signed_size_t(n), signed_size_t(x.size() - n)),
+            freqs,
+            fs);
+        REQUIRE(dft_error(sdft.values(), y) < 1E-12);
+        REQUIRE(dft_error(sdft_drift.values(), y) < 1E-8);
+    }
+
+    SECTION("Complex") {
+        const auto x = random::randn<double>(1000) +
+                       1.0i * random::randn<double>(1000);
+        SlidingDFT<double, std::complex<double>> sdft(64, {-93.75, 250.0}, fs);
+        sdft.push(x);
+        const auto X = fft(utils::subvector(x, 64, 936));
+        REQUIRE(dft_error(sdft.values(), std::vector{X[58], X[16]}) < 1E-12);
+    }
+}
+
+} // namespace scicpp::signal
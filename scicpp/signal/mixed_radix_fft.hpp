@@ -0,0 +1,1328 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#ifndef SCICPP_SIGNAL_MIXED_RADIX_FFT
+#define SCICPP_SIGNAL_MIXED_RADIX_FFT
+
+#include "scicpp/core/macros.hpp"
+#include "scicpp/core/thread_pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <type_traits>
+#include <unsupported/Eigen/FFT>
+#include <utility>
+#include <vector>
+
+//---------------------------------------------------------------------------------
+// Mixed-radix FFT
+//
+// Stockham autosort FFT with radix 4, 2, 3, 5 and 7 butterflies.
+//
+// The real and imaginary parts are stored in separate arrays, so that
+// a butterfly computes several independent sub-transforms at once on SIMD
+// vectors (SSE, AVX or AVX-512, the widest one supported by the CPU).
+//
+// Real inputs of even size N are computed with a complex FFT of size N / 2.
+//
+// Large transforms use the four-step FFT, multithreaded.
+//
+// Sizes with a prime factor larger than 7 are computed by Eigen's kissfft.
+//---------------------------------------------------------------------------------
+
+namespace scicpp::signal::detail {
+
+namespace simd {
+
+// Size in bytes of the widest SIMD register of the target
+#if defined(__AVX512F__)
+constexpr std::size_t max_bytes = 64;
+#elif defined(__AVX__)
+constexpr std::size_t max_bytes = 32;
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+constexpr std::size_t max_bytes = 16;
+#else
+constexpr std::size_t max_bytes = 0;
+#endif
+
+// Vector of bytes / sizeof(T) lanes, the scalar type if bytes is 0
+template <typename T, std::size_t bytes>
+struct Vec {
+    using type = T;
+};
+
+template <>
+struct Vec<float, 16> {
+    typedef float type __attribute__((vector_size(16)));
+};
+
+template <>
+struct Vec<double, 16> {
+    typedef double type __attribute__((vector_size(16)));
+};
+
+template <>
+struct Vec<float, 32> {
+    typedef float type __attribute__((vector_size(32)));
+};
+
+template <>
+struct Vec<double, 32> {
+    typedef double type __attribute__((vector_size(32)));
+};
+
+template <>
+struct Vec<float, 64> {
+    typedef float type __attribute__((vector_size(64)));
+};
+
+template <>
+struct Vec<double, 64> {
+    typedef double type __attribute__((vector_size(64)));
+};
+
+template <typename T, std::size_t bytes>
+using vec_t = typename Vec<T, bytes>::type;
+
+template <typename T, class V>
+constexpr std::size_t lanes = sizeof(V) / sizeof(T);
+
+// Vectors are not passed by value, whose ABI depends on the target
+// (see stages below).
+template <class V, typename T>
+void load(V &v, const T *ptr) {
+    std::memcpy(&v, ptr, sizeof(V));
+}
+
+template <class V, typename T>
+void store(T *ptr, const V &v) {
+    std::memcpy(ptr, &v, sizeof(V));
+}
+
+} // namespace simd
+
+//---------------------------------------------------------------------------------
+// Butterflies
+//---------------------------------------------------------------------------------
+
+// cos(2 pi k / P) and sin(2 pi k / P) for k = 1, ..., (P - 1) / 2
+template <typename T, std::size_t P>
+struct UnitRoots;
+
+template <typename T>
+struct UnitRoots<T, 3> {
+    static constexpr std::array<T, 1> cos{T(-0.5L)};
+    static constexpr std::array<T, 1> sin{
+        T(0.866025403784438646763723170752936183L)};
+};
+
+template <typename T>
+struct UnitRoots<T, 5> {
+    static constexpr std::array<T, 2> cos{
+        T(0.309016994374947424102293417182819059L),
+        T(-0.809016994374947424102293417182819059L)};
+    static constexpr std::array<T, 2> sin{
+        T(0.951056516295153572116439333379382143L),
+        T(0.587785252292473129168705954639072769L)};
+};
+
+template <typename T>
+struct UnitRoots<T, 7> {
+    static constexpr std::array<T, 3> cos{
+        T(0.623489801858733530525004884004239811L),
+        T(-0.222520933956314404288902564496794759L),
+        T(-0.900968867902419126236102319507445051L)};
+    static constexpr std::array<T, 3> sin{
+        T(0.781831482468029808708444526674057750L),
+        T(0.974927912181823607018131682993931217L),
+        T(0.433883739117558120475768332848358755L)};
+};
+
+// In-place DFT of size P on (re, im): b[r] = sum_k a[k] exp(-2 i pi r k / P)
+template <typename T, std::size_t P, class V>
+void small_dft(V *re, V *im) {
+    if constexpr (P == 2) {
+        const V r0 = re[0] + re[1];
+        const V i0 = im[0] + im[1];
+        re[1] = re[0] - re[1];
+        im[1] = im[0] - im[1];
+        re[0] = r0;
+        im[0] = i0;
+    } else if constexpr (P == 4) {
+        const V t0r = re[0] + re[2], t0i = im[0] + im[2];
+        const V t1r = re[0] - re[2], t1i = im[0] - im[2];
+        const V t2r = re[1] + re[3], t2i = im[1] + im[3];
+        const V t3r = re[1] - re[3], t3i = im[1] - im[3];
+        re[0] = t0r + t2r;
+        im[0] = t0i + t2i;
+        re[1] = t1r + t3i;
+        im[1] = t1i - t3r;
+        re[2] = t0r - t2r;
+        im[2] = t0i - t2i;
+        re[3] = t1r - t3i;
+        im[3] = t1i + t3r;
+    } else {
+        // Odd P: pair the inputs k and P - k
+        using Roots = UnitRoots<T, P>;
+        constexpr std::size_t h = (P - 1) / 2;
+        std::array<V, h> sum_r, sum_i, dif_r, dif_i;
+        V b0r = re[0];
+        V b0i = im[0];
+
+        for (std::size_t k = 1; k <= h; ++k) {
+            sum_r[k - 1] = re[k] + re[P - k];
+            sum_i[k - 1] = im[k] + im[P - k];
+            dif_r[k - 1] = re[k] - re[P - k];
+            dif_i[k - 1] = im[k] - im[P - k];
+            b0r += sum_r[k - 1];
+            b0i += sum_i[k - 1];
+        }
+
+        for (std::size_t r = 1; r <= h; ++r) {
+            V ar = re[0];
+            V ai = im[0];
+            V br{};
+            V bi{};
+
+            for (std::size_t k = 1; k <= h; ++k) {
+                const auto idx = (r * k) % P;
+                const auto c = Roots::cos[std::min(idx, P - idx) - 1];
+                const auto s =
+                    idx <= h ? Roots::sin[idx - 1] : -Roots::sin[P - idx - 1];
+                ar += sum_r[k - 1] * c;
+                ai += sum_i[k - 1] * c;
+                br += dif_r[k - 1] * s;
+                bi += dif_i[k - 1] * s;
+            }
+
+            re[r] = ar + bi;
+            im[r] = ai - br;
+            re[P - r] = ar - bi;
+            im[P - r] = ai + br;
+        }
+
+        re[0] = b0r;
+        im[0] = b0i;
+    }
+}
+
+// Radix-P butterfly on the inputs x[k * xs], k = 0, ..., P - 1.
+// The outputs, multiplied by the twiddles w[r], are stored in y[r * ys].
+template <typename T, std::size_t P, class V>
+void butterfly(const T *xr,
+               const T *xi,
+               T *yr,
+               T *yi,
+               std::size_t xs,
+               std::size_t ys,
+               const std::array<T, P> &wr,
+               const std::array<T, P> &wi) {
+    std::array<V, P> re, im;
+
+    for (std::size_t k = 0; k < P; ++k) {
+        simd::load(re[k], xr + k * xs);
+        simd::load(im[k], xi + k * xs);
+    }
+
+    small_dft<T, P>(re.data(), im.data());
+    simd::store(yr, re[0]);
+    simd::store(yi, im[0]);
+
+    for (std::size_t r = 1; r < P; ++r) {
+        simd::store(yr + r * ys, re[r] * wr[r] - im[r] * wi[r]);
+        simd::store(yi + r * ys, re[r] * wi[r] + im[r] * wr[r]);
+    }
+}
+
+//---------------------------------------------------------------------------------
+// Stockham stages
+//
+// A stage of radix P, stride s and m = n / (P s) computes for j < m, q < s:
+// y[q + s (P j + r)] = w^(j r) sum_k x[q + s (j + k m)] exp(-2 i pi r k / P),
+// with w = exp(-2 i pi / (P m)) and the twiddles w^(j r) stored at
+// tw[(r - 1) m + j].
+//---------------------------------------------------------------------------------
+
+// Vectorized over q (requires s >= lanes)
+template <typename T, std::size_t P, class V>
+void stage_strided(std::size_t s,
+                   std::size_t m,
+                   const T *twr,
+                   const T *twi,
+                   const T *xr,
+                   const T *xi,
+                   T *yr,
+                   T *yi) {
+    constexpr auto W = simd::lanes<T, V>;
+    std::array<T, P> wr{}, wi{};
+
+    for (std::size_t j = 0; j < m; ++j) {
+        for (std::size_t r = 1; r < P; ++r) {
+            wr[r] = twr[(r - 1) * m + j];
+            wi[r] = twi[(r - 1) * m + j];
+        }
+
+        const auto x = s * j;
+        const auto y = s * P * j;
+        std::size_t q = 0;
+
+        for (; q + W <= s; q += W) {
+            butterfly<T, P, V>(xr + x + q,
+                               xi + x + q,
+                               yr + y + q,
+                               yi + y + q,
+                               s * m,
+                               s,
+                               wr,
+                               wi);
+        }
+
+        for (; q < s; ++q) {
+            butterfly<T, P, T>(xr + x + q,
+                               xi + x + q,
+                               yr + y + q,
+                               yi + y + q,
+                               s * m,
+                               s,
+                               wr,
+                               wi);
+        }
+    }
+}
+
+// First stage (s = 1), vectorized over j
+template <typename T, std::size_t P, class V>
+void stage_first(std::size_t m,
+                 const T *twr,
+                 const T *twi,
+                 const T *xr,
+                 const T *xi,
+                 T *yr,
+                 T *yi) {
+    constexpr auto W = simd::lanes<T, V>;
+    std::size_t j = 0;
+
+    for (; j + W <= m; j += W) {
+        std::array<V, P> re, im;
+
+        for (std::size_t k = 0; k < P; ++k) {
+            simd::load(re[k], xr + j + k * m);
+            simd::load(im[k], xi + j + k * m);
+        }
+
+        small_dft<T, P>(re.data(), im.data());
+
+        for (std::size_t r = 1; r < P; ++r) {
+            V wr, wi;
+            simd::load(wr, twr + (r - 1) * m + j);
+            simd::load(wi, twi + (r - 1) * m + j);
+            const V tr = re[r] * wr - im[r] * wi;
+            im[r] = re[r] * wi + im[r] * wr;
+            re[r] = tr;
+        }
+
+        for (std::size_t l = 0; l < W; ++l) {
+            for (std::size_t r = 0; r < P; ++r) {
+                yr[P * (j + l) + r] = re[r][l];
+                yi[P * (j + l) + r] = im[r][l];
+            }
+        }
+    }
+
+    if (j < m) {
+        std::array<T, P> wr{}, wi{};
+
+        for (; j < m; ++j) {
+            for (std::size_t r = 1; r < P; ++r) {
+                wr[r] = twr[(r - 1) * m + j];
+                wi[r] = twi[(r - 1) * m + j];
+            }
+
+            butterfly<T, P, T>(
+                xr + j, xi + j, yr + P * j, yi + P * j, m, 1, wr, wi);
+        }
+    }
+}
+
+// Run the stage with the widest vector that fits
+template <typename T, std::size_t P, std::size_t bytes = simd::max_bytes>
+void stage(std::size_t s,
+           std::size_t m,
+           const T *twr,
+           const T *twi,
+           const T *xr,
+           const T *xi,
+           T *yr,
+           T *yi) {
+    if constexpr (bytes < 16) {
+        stage_strided<T, P, T>(s, m, twr, twi, xr, xi, yr, yi);
+    } else {
+        using V = simd::vec_t<T, bytes>;
+        constexpr auto W = simd::lanes<T, V>;
+
+        if (s >= W) {
+            stage_strided<T, P, V>(s, m, twr, twi, xr, xi, yr, yi);
+        } else if (s == 1 && m >= W) {
+            stage_first<T, P, V>(m, twr, twi, xr, xi, yr, yi);
+        } else {
+            stage<T, P, bytes / 2>(s, m, twr, twi, xr, xi, yr, yi);
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------
+// Mixed-radix FFT engine
+//---------------------------------------------------------------------------------
+
+template <typename T>
+struct MixedRadixPlan {
+    std::vector<std::size_t> radices;
+    std::vector<T> twr; // Twiddles of all stages
+    std::vector<T> twi;
+    std::vector<T> rtwr; // Real FFT twiddles exp(-i pi k / n), k < n
+    std::vector<T> rtwi;
+};
+
+// Run the stages of plan p on the split array (ar, ai) of size n,
+// with vectors of at most bytes. (br, bi) is a work buffer.
+// Returns the split result.
+template <typename T, std::size_t bytes>
+std::pair<T *, T *> run_stages(const MixedRadixPlan<T> &p,
+                               std::size_t n,
+                               T *ar,
+                               T *ai,
+                               T *br,
+                               T *bi) {
+    const T *twr = p.twr.data();
+    const T *twi = p.twi.data();
+    std::size_t s = 1;
+    std::size_t m = n;
+
+    for (const auto radix : p.radices) {
+        m /= radix;
+
+        switch (radix) {
+        case 2:
+            stage<T, 2, bytes>(s, m, twr, twi, ar, ai, br, bi);
+            break;
+        case 3:
+            stage<T, 3, bytes>(s, m, twr, twi, ar, ai, br, bi);
+            break;
+        case 4:
+            stage<T, 4, bytes>(s, m, twr, twi, ar, ai, br, bi);
+            break;
+        case 5:
+            stage<T, 5, bytes>(s, m, twr, twi, ar, ai, br, bi);
+            break;
+        case 7:
+            stage<T, 7, bytes>(s, m, twr, twi, ar, ai, br, bi);
+            break;
+        default:
+            scicpp_unreachable;
+        }
+
+        std::swap(ar, br);
+        std::swap(ai, bi);
+        twr += (radix - 1) * m;
+        twi += (radix - 1) * m;
+        s *= radix;
+    }
+
+    return {ar, ai};
+}
+
+#ifdef SCICPP_RUNTIME_DISPATCH
+
+// The butterflies are also compiled for AVX-512 and AVX2 vectors,
+// flattened into functions targeting these instruction sets,
+// and selected from the CPU features at run time.
+
+template <typename T>
+__attribute__((target("arch=x86-64-v4"), flatten)) std::pair<T *, T *>
+run_stages_v4(const MixedRadixPlan<T> &p,
+              std::size_t n,
+              T *ar,
+              T *ai,
+              T *br,
+              T *bi) {
+    return run_stages<T, 64>(p, n, ar, ai, br, bi);
+}
+
+template <typename T>
+__attribute__((target("arch=x86-64-v3"), flatten)) std::pair<T *, T *>
+run_stages_v3(const MixedRadixPlan<T> &p,
+              std::size_t n,
+              T *ar,
+              T *ai,
+              T *br,
+              T *bi) {
+    return run_stages<T, 32>(p, n, ar, ai, br, bi);
+}
+
+#endif // SCICPP_RUNTIME_DISPATCH
+
+// Run the stages with the widest vectors supported by the CPU
+template <typename T>
+std::pair<T *, T *> run_stages(const MixedRadixPlan<T> &p,
+                               std::size_t n,
+                               T *ar,
+                               T *ai,
+                               T *br,
+                               T *bi) {
+#ifdef SCICPP_RUNTIME_DISPATCH
+    static const auto cpu_bytes = []() {
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("x86-64-v4")) {
+            return 64;
+        } else if (__builtin_cpu_supports("x86-64-v3")) {
+            return 32;
+        }
+
+        return 0;
+    }();
+
+    if (cpu_bytes == 64) {
+        return run_stages_v4(p, n, ar, ai, br, bi);
+    } else if (cpu_bytes == 32 && simd::max_bytes < 32) {
+        return run_stages_v3(p, n, ar, ai, br, bi);
+    }
+#endif
+
+    return run_stages<T, simd::max_bytes>(p, n, ar, ai, br, bi);
+}
+
+template <typename T, bool half_spectrum>
+class MixedRadixFFT;
+
+// a * b, or a * conj(b), without the inf/nan handling of std::complex
+template <typename T>
+std::complex<T>
+complex_mul(std::complex<T> a, std::complex<T> b, bool conj_b = false) {
+    const auto bi = conj_b ? -b.imag() : b.imag();
+    return {a.real() * b.real() - a.imag() * bi,
+            a.real() * bi + a.imag() * b.real()};
+}
+
+//---------------------------------------------------------------------------------
+// Four-step FFT
+//
+// Large transforms of size n = n1 n2 (n1 ~ n2 ~ sqrt(n)) are computed as
+// n2 FFTs of size n1 and n1 FFTs of size n2 on contiguous rows, with
+// blocked transposes in between, so that each sub-FFT fits in the cache.
+// The rows, the transposes and the twiddle multiplications are spread
+// across the library thread pool.
+//---------------------------------------------------------------------------------
+
+template <typename T>
+struct FourStepPlan {
+    std::size_t n1 = 0;
+    std::size_t n2 = 0;
+    // Twiddles exp(-2 i pi e / n) = tw1[e % n1] tw2[e / n1]
+    std::vector<std::complex<T>> tw1;
+    std::vector<std::complex<T>> tw2;
+    // Real FFT twiddles exp(-i pi e / n) = rtw1[e % n1] rtw2[e / n1]
+    std::vector<std::complex<T>> rtw1;
+    std::vector<std::complex<T>> rtw2;
+};
+
+template <typename T>
+class FourStepFFT {
+  public:
+    using Complex = std::complex<T>;
+
+    // Complex transforms of at least min_size points use the four-step FFT
+    static constexpr std::size_t min_size = std::size_t(1) << 18;
+
+    static bool is_large(std::size_t n, bool real_input) {
+        return real_input && n % 2 == 0 ? n / 2 >= min_size : n >= min_size;
+    }
+
+    void fwd(Complex *dst, const Complex *src, std::size_t n) {
+        transform(dst, src, work_buffer(n), n, false);
+    }
+
+    void inv(Complex *dst, const Complex *src, std::size_t n) {
+        transform(dst, src, work_buffer(n), n, true);
+    }
+
+    // Half spectrum (n / 2 + 1 values) of the real signal src
+    void fwd(Complex *dst, const T *src, std::size_t n) {
+        if (n % 2 != 0) {
+            Complex *a = work_buffer(2 * n);
+            Complex *b = a + n;
+
+            for_each_block(n, [&](std::size_t k) { a[k] = src[k]; });
+            transform(b, a, a, n, false);
+            std::copy(b, b + n / 2 + 1, dst);
+            return;
+        }
+
+        // Complex FFT z of (x[0] + i x[1], x[2] + i x[3], ...), see rfft_even
+        const auto m = n / 2;
+        Complex *a = work_buffer(n);
+        Complex *z = a + m;
+
+        for_each_block(
+            m, [&](std::size_t k) { a[k] = {src[2 * k], src[2 * k + 1]}; });
+        transform(z, a, a, m, false);
+
+        const auto &p = plan(m);
+        dst[0] = {z[0].real() + z[0].imag(), T{0}};
+        dst[m] = {z[0].real() - z[0].imag(), T{0}};
+
+        for_each_row(p.n2, [&](std::size_t hi) {
+            for (std::size_t lo = hi == 0 ? 1 : 0; lo < p.n1; ++lo) {
+                const auto k = lo + p.n1 * hi;
+                const auto z1 = z[k];
+                const auto z2 = std::conj(z[m - k]);
+                const auto e = T(0.5) * (z1 + z2);
+                const auto d = T(0.5) * (z1 - z2);
+                const auto o = Complex(d.imag(), -d.real());
+                const auto w = complex_mul(p.rtw1[lo], p.rtw2[hi]);
+                dst[k] = e + complex_mul(o, w);
+            }
+        });
+    }
+
+    // Real signal of size n from the n / 2 + 1 values of its half spectrum
+    void inv(T *dst, const Complex *src, std::size_t n) {
+        if (n % 2 != 0) {
+            Complex *a = work_buffer(2 * n);
+            Complex *b = a + n;
+
+            for_each_block(n, [&](std::size_t k) {
+                if (k == 0) {
+                    a[k] = src[0].real();
+                } else {
+                    a[k] = k <= n / 2 ? src[k] : std::conj(src[n - k]);
+                }
+            });
+
+            transform(b, a, a, n, true);
+            for_each_block(n, [&](std::size_t k) { dst[k] = b[k].real(); });
+            return;
+        }
+
+        // Inverse of the real FFT above, see irfft_even
+        const auto m = n / 2;
+        Complex *a = work_buffer(n);
+        Complex *z = a + m;
+        const auto &p = plan(m);
+        const auto x0 = src[0].real();
+        const auto xm = src[m].real();
+        a[0] = T(0.5) * Complex(x0 + xm, x0 - xm);
+
+        for_each_row(p.n2, [&](std::size_t hi) {
+            for (std::size_t lo = hi == 0 ? 1 : 0; lo < p.n1; ++lo) {
+                const auto k = lo + p.n1 * hi;
+                const auto x1 = src[k];
+                const auto x2 = std::conj(src[m - k]);
+                const auto e = x1 + x2;
+                const auto w = complex_mul(p.rtw1[lo], p.rtw2[hi]);
+                const auto o = complex_mul(x1 - x2, w, true);
+                a[k] = T(0.5) * (e + Complex(-o.imag(), o.real()));
+            }
+        });
+
+        transform(z, a, a, m, true);
+
+        for_each_block(m, [&](std::size_t k) {
+            dst[2 * k] = z[k].real();
+            dst[2 * k + 1] = z[k].imag();
+        });
+    }
+
+  private:
+    std::map<std::size_t, FourStepPlan<T>> m_plans;
+    std::vector<Complex> m_buffer;
+
+    Complex *work_buffer(std::size_t n) {
+        if (m_buffer.size() < n) {
+            m_buffer.resize(n);
+        }
+
+        return m_buffer.data();
+    }
+
+    // Tiles of 128 bytes per row, i.e. two cache lines
+    static constexpr std::size_t tile_size = 128 / sizeof(Complex);
+
+    // Buffer of the calling thread for a tile of columns
+    static Complex *tile_buffer(std::size_t size) {
+        thread_local std::vector<Complex> buffer;
+
+        if (buffer.size() < size) {
+            buffer.resize(size);
+        }
+
+        return buffer.data();
+    }
+
+    // Engine of the calling thread for the sub-FFTs
+    static auto &row_engine() {
+        thread_local MixedRadixFFT<T, false> engine;
+        return engine;
+    }
+
+    template <class Func>
+    static void for_each_row(std::size_t nrows, Func &&func) {
+        global_thread_pool().parallel_for(
+            signed_size_t(nrows),
+            [&](signed_size_t i) { func(std::size_t(i)); });
+    }
+
+    // Call func(k) for k < n, by blocks of consecutive indices
+    template <class Func>
+    static void for_each_block(std::size_t n, Func &&func) {
+        constexpr std::size_t block = 1 << 14;
+
+        for_each_row((n + block - 1) / block, [&](std::size_t i) {
+            const auto k1 = std::min(n, (i + 1) * block);
+
+            for (auto k = i * block; k < k1; ++k) {
+                func(k);
+            }
+        });
+    }
+
+    const FourStepPlan<T> &plan(std::size_t n) {
+        auto it = m_plans.find(n);
+
+        if (it != m_plans.end()) {
+            return it->second;
+        }
+
+        constexpr auto pi = 3.141592653589793238462643383279502884L;
+        FourStepPlan<T> p;
+
+        // Largest divisor of n not larger than sqrt(n)
+        for (p.n1 = std::size_t(std::sqrt(double(n))); n % p.n1 != 0;) {
+            --p.n1;
+        }
+
+        p.n2 = n / p.n1;
+
+        const auto root = [n](std::size_t e, long double scale) {
+            const auto phi = -scale * pi * static_cast<long double>(e) /
+                             static_cast<long double>(n);
+            return Complex(T(std::cos(phi)), T(std::sin(phi)));
+        };
+
+        for (std::size_t lo = 0; lo < p.n1; ++lo) {
+            p.tw1.push_back(root(lo, 2));
+            p.rtw1.push_back(root(lo, 1));
+        }
+
+        for (std::size_t hi = 0; hi < p.n2; ++hi) {
+            p.tw2.push_back(root(p.n1 * hi, 2));
+            p.rtw2.push_back(root(p.n1 * hi, 1));
+        }
+
+        return m_plans.emplace(n, std::move(p)).first->second;
+    }
+
+    // Complex FFT of in (n1 x n2) into out.
+    //
+    // The columns of in are transformed by tiles of tile_size columns,
+    // gathered into a per-thread buffer and written to work as rows.
+    // work may be in, but not out (out may be in).
+    void transform(Complex *out,
+                   const Complex *in,
+                   Complex *work,
+                   std::size_t n,
+                   bool inverse) {
+        const auto &p = plan(n);
+        const auto n1 = p.n1;
+        const auto n2 = p.n2;
+        const auto ntiles = [](std::size_t size) {
+            return (size + tile_size - 1) / tile_size;
+        };
+
+        // FFTs of size n1 of the columns j of in, times exp(-2 i pi j k / n)
+        for_each_row(ntiles(n2), [&](std::size_t t) {
+            const auto j0 = t * tile_size;
+            const auto nj = std::min(tile_size, n2 - j0);
+            const auto cols = tile_buffer(nj * n1);
+            auto &engine = row_engine();
+
+            for (std::size_t k = 0; k < n1; ++k) {
+                for (std::size_t i = 0; i < nj; ++i) {
+                    cols[i * n1 + k] = in[k * n2 + j0 + i];
+                }
+            }
+
+            for (std::size_t i = 0; i < nj; ++i) {
+                const auto j = j0 + i;
+                const auto col = cols + i * n1;
+                inverse ? engine.inv(col, col, signed_size_t(n1))
+                        : engine.fwd(col, col, signed_size_t(n1));
+
+                // Exponent e = j k mod n = lo + n1 hi
+                std::size_t lo = 0;
+                std::size_t hi = 0;
+
+                for (std::size_t k = 1; k < n1; ++k) {
+                    lo += j % n1;
+                    hi += j / n1;
+
+                    if (lo >= n1) {
+                        lo -= n1;
+                        ++hi;
+                    }
+
+                    if (hi >= n2) {
+                        hi -= n2;
+                    }
+
+                    const auto w = complex_mul(p.tw1[lo], p.tw2[hi]);
+                    col[k] = complex_mul(col[k], w, inverse);
+                }
+            }
+
+            for (std::size_t k = 0; k < n1; ++k) {
+                for (std::size_t i = 0; i < nj; ++i) {
+                    work[k * n2 + j0 + i] = cols[i * n1 + k];
+                }
+            }
+        });
+
+        // FFTs of size n2 of the rows k of work, transposed into out
+        for_each_row(ntiles(n1), [&](std::size_t t) {
+            const auto k0 = t * tile_size;
+            const auto nk = std::min(tile_size, n1 - k0);
+            auto &engine = row_engine();
+
+            for (std::size_t i = 0; i < nk; ++i) {
+                const auto row = work + (k0 + i) * n2;
+                inverse ? engine.inv(row, row, signed_size_t(n2))
+                        : engine.fwd(row, row, signed_size_t(n2));
+            }
+
+            for (std::size_t j = 0; j < n2; ++j) {
+                for (std::size_t i = 0; i < nk; ++i) {
+                    out[j * n1 + k0 + i] = work[(k0 + i) * n2 + j];
+                }
+            }
+        });
+    }
+}; // class FourStepFFT
+
+//---------------------------------------------------------------------------------
+// Chirp Z-transform (Bluestein's algorithm)
+//
+// X[k] = sum_{j < n} x[j] a^-j w^(j k), for k < m.
+//
+// With j k = (j^2 + k^2 - (k - j)^2) / 2:
+// X[k] = w^(k^2 / 2) sum_j (x[j] a^-j w^(j^2 / 2)) w^(-(k - j)^2 / 2),
+// a convolution with the chirp w^(-l^2 / 2), -n < l < m, computed with
+// FFTs of size nfft >= n + m - 1 without prime factors larger than 7.
+//
+// The chirps and the spectrum of the convolution kernel are computed once,
+// so a transform costs two FFTs of size nfft, whatever the prime factors
+// of n and the number of output points m.
+//---------------------------------------------------------------------------------
+
+// Smallest size >= n without prime factors larger than 7
+scicpp_const inline std::size_t next_smooth_size(std::size_t n) {
+    for (;; ++n) {
+        auto rem = n;
+
+        for (const std::size_t p : {2U, 3U, 5U, 7U}) {
+            while (rem % p == 0) {
+                rem /= p;
+            }
+        }
+
+        if (rem == 1) {
+            return n;
+        }
+    }
+}
+
+template <typename T>
+class ChirpZ {
+  public:
+    using Complex = std::complex<T>;
+
+    // Transform of n inputs into m outputs, with chirp(k) = w^(k^2 / 2)
+    // and ramp(k) = a^-k (as std::complex<long double>).
+    // engine computes the FFTs of size fft_size().
+    template <class Chirp, class Ramp, class Engine>
+    ChirpZ(std::size_t n,
+           std::size_t m,
+           Chirp &&chirp,
+           Ramp &&ramp,
+           Engine &engine)
+        : m_n(n), m_m(m), m_nfft(next_smooth_size(n + m - 1)) {
+        scicpp_require(n > 0 && m > 0);
+
+        m_awk2.resize(n);
+        m_wk2.resize(m);
+
+        for (std::size_t k = 0; k < std::max(n, m); ++k) {
+            const auto wk2 = chirp(k);
+
+            if (k < n) {
+                m_awk2[k] = Complex(ramp(k) * wk2);
+            }
+
+            if (k < m) {
+                m_wk2[k] = Complex(wk2);
+            }
+        }
+
+        // Kernel w^(-l^2 / 2) at index l + n - 1
+        std::vector<Complex> kernel(m_nfft, Complex{0});
+
+        for (std::size_t l = 0; l < m; ++l) {
+            kernel[n - 1 + l] = Complex(1.0L / chirp(l));
+        }
+
+        for (std::size_t l = 1; l < n; ++l) {
+            kernel[n - 1 - l] = Complex(1.0L / chirp(l));
+        }
+
+        m_kernel.resize(m_nfft);
+        engine.fwd(m_kernel.data(), kernel.data(), signed_size_t(m_nfft));
+    }
+
+    std::size_t input_size() const { return m_n; }
+    std::size_t output_size() const { return m_m; }
+    std::size_t fft_size() const { return m_nfft; }
+
+    // Transform the n values of src into the m values of dst.
+    // work is resized to 2 fft_size() values.
+    template <class Engine>
+    void transform(Engine &engine,
+                   Complex *dst,
+                   const Complex *src,
+                   std::vector<Complex> &work) const {
+        work.resize(2 * m_nfft);
+        Complex *u = work.data();
+        Complex *v = work.data() + m_nfft;
+
+        for (std::size_t j = 0; j < m_n; ++j) {
+            u[j] = complex_mul(src[j], m_awk2[j]);
+        }
+
+        std::fill(u + m_n, u + m_nfft, Complex{0});
+        engine.fwd(v, u, signed_size_t(m_nfft));
+
+        for (std::size_t j = 0; j < m_nfft; ++j) {
+            v[j] = complex_mul(v[j], m_kernel[j]);
+        }
+
+        engine.inv(u, v, signed_size_t(m_nfft));
+
+        for (std::size_t k = 0; k < m_m; ++k) {
+            dst[k] = complex_mul(u[m_n - 1 + k], m_wk2[k]);
+        }
+    }
+
+  private:
+    std::size_t m_n;
+    std::size_t m_m;
+    std::size_t m_nfft;
+    std::vector<Complex> m_awk2;   // a^-k w^(k^2 / 2), k < n
+    std::vector<Complex> m_wk2;    // w^(k^2 / 2), k < m
+    std::vector<Complex> m_kernel; // FFT of the kernel
+}; // class ChirpZ
+
+// Drop-in replacement of Eigen::FFT<T> for float and double, exposing the
+// same pointer interface. Inverse transforms are scaled by 1 / n.
+template <typename T, bool half_spectrum = false>
+class MixedRadixFFT {
+    static_assert(std::is_floating_point_v<T>);
+
+  public:
+    using Scalar = T;
+    using Complex = std::complex<T>;
+
+    // Radices, in the order of the stages
+    static constexpr std::array<std::size_t, 5> radices{4, 2, 3, 5, 7};
+
+    scicpp_pure static bool is_supported(std::size_t n) {
+        if (n == 0) {
+            return false;
+        }
+
+        for (const auto p : radices) {
+            while (n % p == 0) {
+                n /= p;
+            }
+        }
+
+        return n == 1;
+    }
+
+    void fwd(Complex *dst, const Complex *src, signed_size_t nfft) {
+        const auto n = std::size_t(nfft);
+
+        if (!is_supported(n)) {
+            if (use_chirp_z(n)) {
+                std::copy(src, src + n, chirp_z_input(n));
+                chirp_z_dft(dst, n);
+            } else {
+                m_fallback.fwd(dst, src, nfft);
+            }
+
+            return;
+        }
+
+        if (FourStepFFT<T>::is_large(n, false)) {
+            m_four_step.fwd(dst, src, n);
+            return;
+        }
+
+        auto [ar, ai] = buffers(n);
+
+        for (std::size_t k = 0; k < n; ++k) {
+            ar[k] = src[k].real();
+            ai[k] = src[k].imag();
+        }
+
+        const auto [yr, yi] = transform(n, ar, ai);
+
+        for (std::size_t k = 0; k < n; ++k) {
+            dst[k] = {yr[k], yi[k]};
+        }
+    }
+
+    // ifft(x) = swap(fft(swap(x))) / n, with swap(a + ib) = b + ia
+    void inv(Complex *dst, const Complex *src, signed_size_t nfft) {
+        const auto n = std::size_t(nfft);
+
+        if (!is_supported(n)) {
+            if (use_chirp_z(n)) {
+                auto x = chirp_z_input(n);
+
+                for (std::size_t k = 0; k < n; ++k) {
+                    x[k] = {src[k].imag(), src[k].real()};
+                }
+
+                chirp_z_dft(dst, n);
+                const auto scale = T{1} / T(n);
+
+                for (std::size_t k = 0; k < n; ++k) {
+                    dst[k] = {scale * dst[k].imag(), scale * dst[k].real()};
+                }
+            } else {
+                m_fallback.inv(dst, src, nfft);
+            }
+
+            return;
+        }
+
+        if (FourStepFFT<T>::is_large(n, false)) {
+            m_four_step.inv(dst, src, n);
+            return;
+        }
+
+        auto [ar, ai] = buffers(n);
+
+        for (std::size_t k = 0; k < n; ++k) {
+            ar[k] = src[k].imag();
+            ai[k] = src[k].real();
+        }
+
+        const auto [yr, yi] = transform(n, ar, ai);
+        const auto scale = T{1} / T(n);
+
+        for (std::size_t k = 0; k < n; ++k) {
+            dst[k] = {scale * yi[k], scale * yr[k]};
+        }
+    }
+
+    void fwd(Complex *dst, const Scalar *src, signed_size_t nfft) {
+        const auto n = std::size_t(nfft);
+
+        if (is_supported(n) && FourStepFFT<T>::is_large(n, true)) {
+            m_four_step.fwd(dst, src, n);
+        } else if (n % 2 == 0 && is_supported(n)) {
+            rfft_even(dst, src, n);
+        } else if (is_supported(n)) {
+            auto [ar, ai] = buffers(n);
+            std::copy(src, src + n, ar);
+            std::fill(ai, ai + n, T{0});
+            const auto [yr, yi] = transform(n, ar, ai);
+
+            for (std::size_t k = 0; k <= n / 2; ++k) {
+                dst[k] = {yr[k], yi[k]};
+            }
+        } else if (use_chirp_z(n)) {
+            std::copy(src, src + n, chirp_z_input(n));
+            chirp_z_dft(chirp_z_output(n), n);
+            std::copy_n(m_chirp_z_output.cbegin(), n / 2 + 1, dst);
+        } else {
+            m_fallback.fwd(dst, src, nfft);
+            return;
+        }
+
+        if constexpr (!half_spectrum) {
+            for (std::size_t k = n / 2 + 1; k < n; ++k) {
+                dst[k] = std::conj(dst[n - k]);
+            }
+        }
+    }
+
+    // Reads the n / 2 + 1 first bins of the (hermitian) spectrum.
+    // The imaginary parts of the DC and Nyquist bins are ignored.
+    void inv(Scalar *dst, const Complex *src, signed_size_t nfft) {
+        const auto n = std::size_t(nfft);
+
+        if (is_supported(n) && FourStepFFT<T>::is_large(n, true)) {
+            m_four_step.inv(dst, src, n);
+        } else if (n % 2 == 0 && is_supported(n)) {
+            irfft_even(dst, src, n);
+        } else if (is_supported(n)) {
+            auto [ar, ai] = buffers(n);
+            ar[0] = T{0};
+            ai[0] = src[0].real();
+
+            for (std::size_t k = 1; k <= n / 2; ++k) {
+                ar[k] = src[k].imag();
+                ai[k] = src[k].real();
+                ar[n - k] = -src[k].imag();
+                ai[n - k] = src[k].real();
+            }
+
+            const auto [yr, yi] = transform(n, ar, ai);
+            const auto scale = T{1} / T(n);
+
+            for (std::size_t k = 0; k < n; ++k) {
+                dst[k] = scale * yi[k];
+            }
+        } else if (use_chirp_z(n)) {
+            // Swapped hermitian spectrum
+            auto x = chirp_z_input(n);
+            x[0] = {T{0}, src[0].real()};
+
+            for (std::size_t k = 1; k <= (n - 1) / 2; ++k) {
+                x[k] = {src[k].imag(), src[k].real()};
+                x[n - k] = {-src[k].imag(), src[k].real()};
+            }
+
+            if (n % 2 == 0) {
+                x[n / 2] = {T{0}, src[n / 2].real()};
+            }
+
+            const auto y = chirp_z_output(n);
+            chirp_z_dft(y, n);
+            const auto scale = T{1} / T(n);
+
+            for (std::size_t k = 0; k < n; ++k) {
+                dst[k] = scale * y[k].imag();
+            }
+        } else {
+            m_fallback.inv(dst, src, nfft);
+        }
+    }
+
+  private:
+    std::map<std::size_t, MixedRadixPlan<T>> m_plans;
+    std::vector<T> m_buffer;
+    FourStepFFT<T> m_four_step;
+    Eigen::FFT<T> m_fallback{
+        typename Eigen::FFT<T>::impl_type(),
+        half_spectrum ? Eigen::FFT<T>::HalfSpectrum : Eigen::FFT<T>::Default};
+
+    // Sizes with a prime factor larger than chirp_z_min_prime are computed
+    // with Bluestein's algorithm, the other ones by kissfft
+    // (whose cost grows linearly with the prime factors).
+    static constexpr std::size_t chirp_z_min_prime = 23;
+
+    std::map<std::size_t, ChirpZ<T>> m_chirp_z;
+    std::vector<Complex> m_chirp_z_input;
+    std::vector<Complex> m_chirp_z_output;
+    std::vector<Complex> m_chirp_z_work;
+
+    scicpp_const static bool use_chirp_z(std::size_t n) {
+        for (std::size_t p = 2; p <= chirp_z_min_prime; ++p) {
+            while (n % p == 0) {
+                n /= p;
+            }
+        }
+
+        return n > 1;
+    }
+
+    Complex *chirp_z_input(std::size_t n) {
+        m_chirp_z_input.resize(n);
+        return m_chirp_z_input.data();
+    }
+
+    Complex *chirp_z_output(std::size_t n) {
+        m_chirp_z_output.resize(n);
+        return m_chirp_z_output.data();
+    }
+
+    // DFT of the n values of m_chirp_z_input, with w = exp(-2 i pi / n)
+    // and a = 1. The FFTs of the chirp-z transform are computed by this
+    // engine, their sizes having no prime factor larger than 7.
+    void chirp_z_dft(Complex *dst, std::size_t n) {
+        auto it = m_chirp_z.find(n);
+
+        if (it == m_chirp_z.end()) {
+            constexpr auto pi = 3.141592653589793238462643383279502884L;
+
+            // w^(k^2 / 2) = exp(-i pi (k^2 mod 2n) / n)
+            const auto chirp = [n](std::size_t k) {
+                const auto k2 = (k * k) % (2 * n);
+                return std::polar(1.0L,
+                                  -pi * static_cast<long double>(k2) /
+                                      static_cast<long double>(n));
+            };
+
+            const auto ramp = [](std::size_t) {
+                return std::complex<long double>{1};
+            };
+
+            it = m_chirp_z.emplace(n, ChirpZ<T>(n, n, chirp, ramp, *this))
+                     .first;
+        }
+
+        it->second.transform(
+            *this, dst, m_chirp_z_input.data(), m_chirp_z_work);
+    }
+
+    // Split (re, im) buffers of n values, the first one is returned.
+    // The buffers are padded by one cache line and a half so that
+    // power of two sizes do not map to the same cache sets.
+    static constexpr std::size_t buffer_pad = 96 / sizeof(T);
+
+    T *buffer(std::size_t n, std::size_t idx) {
+        return m_buffer.data() + idx * (n + buffer_pad);
+    }
+
+    std::pair<T *, T *> buffers(std::size_t n) {
+        if (m_buffer.size() < 4 * (n + buffer_pad)) {
+            m_buffer.resize(4 * (n + buffer_pad));
+        }
+
+        return {buffer(n, 0), buffer(n, 1)};
+    }
+
+    const MixedRadixPlan<T> &plan(std::size_t n) {
+        auto it = m_plans.find(n);
+
+        if (it != m_plans.end()) {
+            return it->second;
+        }
+
+        constexpr auto two_pi = 6.283185307179586476925286766559005768L;
+        MixedRadixPlan<T> p;
+        auto rem = n;
+
+        for (const auto radix : radices) {
+            while (rem % radix == 0) {
+                p.radices.push_back(radix);
+                rem /= radix;
+            }
+        }
+
+        auto len = n;
+
+        for (const auto radix : p.radices) {
+            const auto m = len / radix;
+
+            for (std::size_t r = 1; r < radix; ++r) {
+                for (std::size_t j = 0; j < m; ++j) {
+                    const auto phi = -two_pi * static_cast<long double>(j * r) /
+                                     static_cast<long double>(len);
+                    p.twr.push_back(T(std::cos(phi)));
+                    p.twi.push_back(T(std::sin(phi)));
+                }
+            }
+
+            len = m;
+        }
+
+        for (std::size_t k = 0; k < n; ++k) {
+            const auto phi = -two_pi * static_cast<long double>(k) /
+                             static_cast<long double>(2 * n);
+            p.rtwr.push_back(T(std::cos(phi)));
+            p.rtwi.push_back(T(std::sin(phi)));
+        }
+
+        return m_plans.emplace(n, std::move(p)).first->second;
+    }
+
+    // Complex FFT of the split array (ar, ai) of the buffer,
+    // returns the split result.
+    std::pair<const T *, const T *> transform(std::size_t n, T *ar, T *ai) {
+        return run_stages(plan(n), n, ar, ai, buffer(n, 2), buffer(n, 3));
+    }
+
+    // Real FFT of even size n from the complex FFT z of size m = n / 2 of
+    // (x[0] + i x[1], x[2] + i x[3], ...):
+    // X[k] = E[k] + exp(-2 i pi k / n) O[k], with
+    // E[k] = (z[k] + conj(z[m - k])) / 2 and
+    // O[k] = (z[k] - conj(z[m - k])) / 2i
+    void rfft_even(Complex *dst, const Scalar *src, std::size_t n) {
+        const auto m = n / 2;
+        auto [ar, ai] = buffers(m);
+
+        for (std::size_t k = 0; k < m; ++k) {
+            ar[k] = src[2 * k];
+            ai[k] = src[2 * k + 1];
+        }
+
+        const auto [zr, zi] = transform(m, ar, ai);
+        const auto &p = plan(m);
+
+        dst[0] = {zr[0] + zi[0], T{0}};
+        dst[m] = {zr[0] - zi[0], T{0}};
+
+        for (std::size_t k = 1; k < m; ++k) {
+            const auto e_r = T(0.5) * (zr[k] + zr[m - k]);
+            const auto e_i = T(0.5) * (zi[k] - zi[m - k]);
+            const auto o_r = T(0.5) * (zi[k] + zi[m - k]);
+            const auto o_i = T(0.5) * (zr[m - k] - zr[k]);
+            const auto wr = p.rtwr[k];
+            const auto wi = p.rtwi[k];
+            dst[k] = {e_r + wr * o_r - wi * o_i, e_i + wr * o_i + wi * o_r};
+        }
+    }
+
+    // Inverse of rfft_even: z[k] = E[k] + i O[k], with
+    // E[k] = X[k] + conj(X[m - k]) and O[k] = (X[k] - conj(X[m - k])) w^-k,
+    // then x = ifft(z) (the factor 2 is included in the 1 / n scaling).
+    void irfft_even(Scalar *dst, const Complex *src, std::size_t n) {
+        const auto m = n / 2;
+        auto [ar, ai] = buffers(m);
+        const auto &p = plan(m);
+
+        // Swapped for the inverse transform
+        ar[0] = src[0].real() - src[m].real();
+        ai[0] = src[0].real() + src[m].real();
+
+        for (std::size_t k = 1; k < m; ++k) {
+            const auto e_r = src[k].real() + src[m - k].real();
+            const auto e_i = src[k].imag() - src[m - k].imag();
+            const auto d_r = src[k].real() - src[m - k].real();
+            const auto d_i = src[k].imag() + src[m - k].imag();
+            const auto wr = p.rtwr[k];
+            const auto wi = p.rtwi[k];
+            ar[k] = e_i + d_r * wr + d_i * wi;
+            ai[k] = e_r - d_i * wr + d_r * wi;
+        }
+
+        const auto [yr, yi] = transform(m, ar, ai);
+        const auto scale = T{1} / T(n);
+
+        for (std::size_t k = 0; k < m; ++k) {
+            dst[2 * k] = scale * yi[k];
+            dst[2 * k + 1] = scale * yr[k];
+        }
+    }
+}; // class MixedRadixFFT
+
+} // namespace scicpp::signal::detail
+
+#endif // SCICPP_SIGNAL_MIXED_RADIX_FFT
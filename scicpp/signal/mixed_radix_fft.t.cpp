@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#include "mixed_radix_fft.hpp"
+
+#include "scicpp/core/numeric.hpp"
+#include "scicpp/core/random.hpp"
+
+#include <complex>
+#include <vector>
+
+namespace scicpp::signal::detail {
+
+namespace {
+
+// Largest error between the n first values of x and y,
+// relative to the largest magnitude of y
+template <class ArrayX, class ArrayY>
+auto max_relative_error(const ArrayX &x, const ArrayY &y, std::size_t n) {
+    using T = decltype(std::abs(y[0]));
+    T err{0};
+    T norm{0};
+
+    for (std::size_t i = 0; i < n; ++i) {
+        err = std::max(err, T(std::abs(x[i] - y[i])));
+        norm = std::max(norm, T(std::abs(y[i])));
+    }
+
+    return err / norm;
+}
+
+template <typename T>
+void check_mixed_radix_fft(T tol) {
+    using Complex = std::complex<T>;
+    using Kiss = Eigen::FFT<T>;
+
+    MixedRadixFFT<T> fft;
+    MixedRadixFFT<T, true> rfft;
+    Kiss kiss;
+    Kiss kiss_half(typename Kiss::impl_type(), Kiss::HalfSpectrum);
+
+    // Radices 2, 3, 4, 5, 7, their products, kissfft fallbacks (11, 26)
+    // and Bluestein's algorithm (29, 53, 194, 1009)
+    for (std::size_t n : {2U,   3U,   4U,   5U,   6U,   7U,    8U,    9U,
+                          11U,  12U,  14U,  15U,  16U,  20U,   21U,   25U,
+                          26U,  27U,  29U,  32U,  35U,  49U,   53U,   60U,
+                          64U,  96U,  105U, 128U, 194U, 210U,  243U,  343U,
+                          360U, 1000U, 1009U, 1024U, 4096U}) {
+        const auto N = signed_size_t(n);
+        const auto re = random::rand<T>(n);
+        const auto im = random::rand<T>(n);
+        std::vector<Complex> x(n);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] = {re[i], im[i]};
+        }
+
+        std::vector<Complex> y(n), y_ref(n);
+        std::vector<T> xr(n);
+
+        fft.fwd(y.data(), x.data(), N);
+        kiss.fwd(y_ref.data(), x.data(), N);
+        REQUIRE(max_relative_error(y, y_ref, n) < tol);
+
+        fft.inv(y.data(), x.data(), N);
+        kiss.inv(y_ref.data(), x.data(), N);
+        REQUIRE(max_relative_error(y, y_ref, n) < tol);
+
+        fft.fwd(y.data(), re.data(), N);
+        kiss.fwd(y_ref.data(), re.data(), N);
+        REQUIRE(max_relative_error(y, y_ref, n) < tol);
+
+        rfft.fwd(y.data(), re.data(), N);
+        kiss_half.fwd(y_ref.data(), re.data(), N);
+        REQUIRE(max_relative_error(y, y_ref, n / 2 + 1) < tol);
+
+        rfft.inv(xr.data(), y_ref.data(), N);
+        REQUIRE(max_relative_error(xr, re, n) < tol);
+    }
+}
+
+} // namespace
+
+TEST_CASE("FourStepFFT") {
+    using Complex = std::complex<double>;
+    using Kiss = Eigen::FFT<double>;
+
+    MixedRadixFFT<double> fft;
+    MixedRadixFFT<double, true> rfft;
+    Kiss kiss;
+    Kiss kiss_half(Kiss::impl_type(), Kiss::HalfSpectrum);
+
+    const auto n0 = FourStepFFT<double>::min_size;
+    REQUIRE(!FourStepFFT<double>::is_large(n0 - 1, false));
+    REQUIRE(FourStepFFT<double>::is_large(n0, false));
+    REQUIRE(!FourStepFFT<double>::is_large(n0, true));
+    REQUIRE(FourStepFFT<double>::is_large(2 * n0, true));
+
+    // Square and rectangular splits, odd size
+    for (std::size_t n : {n0, 2 * n0, std::size_t(531441)}) {
+        const auto N = signed_size_t(n);
+        const auto re = random::rand<double>(n);
+        const auto im = random::rand<double>(n);
+        std::vector<Complex> x(n);
+
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] = {re[i], im[i]};
+        }
+
+        std::vector<Complex> y(n), y_ref(n);
+        std::vector<double> xr(n);
+
+        fft.fwd(y.data(), x.data(), N);
+        kiss.fwd(y_ref.data(), x.data(), N);
+        REQUIRE(max_relative_error(y, y_ref, n) < 1E-14);
+
+        fft.inv(y.data(), x.data(), N);
+        kiss.inv(y_ref.data(), x.data(), N);
+        REQUIRE(max_relative_error(y, y_ref, n) < 1E-14);
+
+        // In-place
+        y = x;
+        fft.fwd(y.data(), y.data(), N);
+        kiss.fwd(y_ref.data(), x.data(), N);
+        REQUIRE(max_relative_error(y, y_ref, n) < 1E-14);
+
+        rfft.fwd(y.data(), re.data(), N);
+        kiss_half.fwd(y_ref.data(), re.data(), N);
+        REQUIRE(max_relative_error(y, y_ref, n / 2 + 1) < 1E-14);
+
+        rfft.inv(xr.data(), y_ref.data(), N);
+        REQUIRE(max_relative_error(xr, re, n) < 1E-14);
+    }
+}
+
+TEST_CASE("MixedRadixFFT") {
+    SECTION("Supported sizes") {
+        REQUIRE(!MixedRadixFFT<double>::is_supported(0));
+        REQUIRE(MixedRadixFFT<double>::is_supported(1));
+        REQUIRE(MixedRadixFFT<double>::is_supported(2 * 3 * 4 * 5 * 7));
+        REQUIRE(!MixedRadixFFT<double>::is_supported(11));
+        REQUIRE(!MixedRadixFFT<double>::is_supported(2 * 13));
+    }
+
+    SECTION("Size 1") {
+        MixedRadixFFT<double> fft;
+        std::complex<double> x{1.0, 2.0}, y{};
+        fft.fwd(&y, &x, 1);
+        REQUIRE(y == x);
+        fft.inv(&y, &x, 1);
+        REQUIRE(y == x);
+    }
+
+    SECTION("Nyquist and DC imaginary parts are ignored") {
+        MixedRadixFFT<double, true> rfft;
+        const std::vector<std::complex<double>> y{
+            {1.0, 5.0}, {0.5, -0.5}, {2.0, -3.0}};
+        std::vector<double> x(4);
+        rfft.inv(x.data(), y.data(), 4);
+        // numpy.fft.irfft([1 + 5j, 0.5 - 0.5j, 2 - 3j])
+        REQUIRE(std::abs(x[0] - 1.0) < 1E-15);
+        REQUIRE(std::abs(x[1] - 0.0) < 1E-15);
+        REQUIRE(std::abs(x[2] - 0.5) < 1E-15);
+        REQUIRE(std::abs(x[3] + 0.5) < 1E-15);
+    }
+
+    SECTION("double") {
+        check_mixed_radix_fft<double>(1E-14);
+    }
+
+    SECTION("float") {
+        check_mixed_radix_fft<float>(1E-5f);
+    }
+}
+
+} // namespace scicpp::signal::detail
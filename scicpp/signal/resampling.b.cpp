@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#include "resampling.hpp"
+
+#include "scicpp/core/random.hpp"
+
+NONIUS_BENCHMARK("signal::decimate (double, 1000000, q = 10)",
+                 [](nonius::chronometer meter) {
+                     const auto x = scicpp::random::rand<double>(1000000);
+
+                     meter.measure(
+                         [&]() { return scicpp::signal::decimate(x, 10); });
+                 })
+
+NONIUS_BENCHMARK("signal::resample_poly (double, 1000000, 3 / 2)",
+                 [](nonius::chronometer meter) {
+                     const auto x = scicpp::random::rand<double>(1000000);
+
+                     meter.measure([&]() {
+                         return scicpp::signal::resample_poly(x, 3, 2);
+                     });
+                 })
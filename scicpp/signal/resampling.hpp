@@ -0,0 +1,408 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#ifndef SCICPP_SIGNAL_RESAMPLING
+#define SCICPP_SIGNAL_RESAMPLING
+
+#include "scicpp/core/macros.hpp"
+#include "scicpp/core/meta.hpp"
+#include "scicpp/signal/fir_filter_design.hpp"
+#include "scicpp/signal/windows.hpp"
+
+#include <algorithm>
+#include <array>
+#include <complex>
+#include <cstdlib>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+namespace scicpp::signal {
+
+//---------------------------------------------------------------------------------
+// UpFirDn
+//
+// Streaming polyphase upsample, FIR filter and downsample.
+//
+// The output y[k] = sum_j h[j] * xu[k * down - j], where xu is x upsampled
+// by inserting up - 1 zeros between samples, is computed from the phase
+// (k * down) % up of the filter only: the inserted zeros are never
+// multiplied and the outputs dropped by the downsampling are never computed.
+//
+// Blocks of any size are processed continuously, flush() returns the tail
+// of the response, so that the concatenated outputs equal upfirdn on the
+// whole signal.
+//---------------------------------------------------------------------------------
+
+namespace detail {
+
+constexpr std::size_t polyphase_lanes = 8;
+
+// sum_j h[j] * x[j], where m is a multiple of polyphase_lanes,
+// with independent partial sums such that the loop vectorizes.
+template <typename R, typename T>
+scicpp_pure T polyphase_dot(const R *h, const T *x, std::size_t m) {
+    std::array<T, polyphase_lanes> acc{};
+
+    for (std::size_t j = 0; j < m; j += polyphase_lanes) {
+        for (std::size_t l = 0; l < polyphase_lanes; ++l) {
+            acc[l] += x[j + l] * h[j + l];
+        }
+    }
+
+    return std::accumulate(acc.cbegin(), acc.cend(), T{0});
+}
+
+} // namespace detail
+
+template <typename T = double>
+class UpFirDn {
+  public:
+    // Type of the filter coefficients (real for complex signals)
+    using R = decltype(std::real(T{}));
+
+    template <class Array>
+    explicit UpFirDn(const Array &h, std::size_t up = 1, std::size_t down = 1)
+        : m_up(up),
+          m_down(down),
+          m_ntaps(h.size()),
+          m_phase_len(phase_length(h.size(), up)) {
+        static_assert(meta::is_iterable_v<Array>);
+        scicpp_require(!h.empty());
+        scicpp_require(m_up > 0 && m_down > 0);
+
+        // Phase p holds h[p + l * up] for l in [0, m_phase_len), reversed
+        // (zero-padded at the beginning up to m_phase_len)
+        m_phases.assign(m_up * m_phase_len, R{0});
+
+        for (std::size_t j = 0; j < m_ntaps; ++j) {
+            const auto p = j % m_up;
+            const auto l = j / m_up;
+            m_phases[p * m_phase_len + (m_phase_len - 1 - l)] = R(h[j]);
+        }
+
+        m_buf.assign(m_phase_len - 1 + chunk_size, T{0});
+    }
+
+    // Filter a block of samples: the outputs that depend on input samples
+    // up to the last sample of the block.
+    void filter(const std::vector<T> &x, std::vector<T> &y) {
+        scicpp_require(&x != &y);
+        y.resize(output_size(x.size()));
+        auto out = y.begin();
+
+        for (std::size_t n0 = 0; n0 < x.size(); n0 += chunk_size) {
+            const auto len = std::min(chunk_size, x.size() - n0);
+            const auto hist = signed_size_t(m_phase_len - 1);
+
+            std::copy_n(x.cbegin() + signed_size_t(n0),
+                        len,
+                        m_buf.begin() + hist);
+
+            for (; m_t < len * m_up; m_t += m_down) {
+                const auto h = m_phases.data() + (m_t % m_up) * m_phase_len;
+                *out = detail::polyphase_dot(
+                    h, m_buf.data() + m_t / m_up, m_phase_len);
+                ++out;
+            }
+
+            // Keep the last samples for the outputs of the next chunk
+            std::copy_n(
+                m_buf.cbegin() + signed_size_t(len), hist, m_buf.begin());
+            m_t -= len * m_up;
+        }
+
+        m_nin += x.size();
+        m_nout += y.size();
+    }
+
+    auto filter(const std::vector<T> &x) {
+        std::vector<T> y;
+        filter(x, y);
+        return y;
+    }
+
+    // Remaining outputs of the response to the samples filtered so far,
+    // then reset the filter.
+    auto flush() {
+        const auto total =
+            m_nin == 0 ? 0 : ((m_nin - 1) * m_up + m_ntaps - 1) / m_down + 1;
+        auto y = filter(std::vector<T>(m_phase_len, T{0}));
+        y.resize(total - (m_nout - y.size()));
+        reset();
+        return y;
+    }
+
+    // Clear the filter state
+    void reset() {
+        std::fill(m_buf.begin(), m_buf.end(), T{0});
+        m_t = 0;
+        m_nin = 0;
+        m_nout = 0;
+    }
+
+    auto up() const { return m_up; }
+
+    auto down() const { return m_down; }
+
+    // Number of outputs of filter for a block of n samples
+    std::size_t output_size(std::size_t n) const {
+        return m_t < n * m_up ? (n * m_up - 1 - m_t) / m_down + 1 : 0;
+    }
+
+  private:
+    // Number of input samples copied at once after the state
+    static constexpr std::size_t chunk_size = 4096;
+
+    // Number of coefficients of each phase, rounded up to a multiple
+    // of the dot product lanes
+    static std::size_t phase_length(std::size_t ntaps, std::size_t up) {
+        constexpr auto lanes = detail::polyphase_lanes;
+        const auto len = (ntaps + up - 1) / std::max(up, std::size_t(1));
+        return (len + lanes - 1) / lanes * lanes;
+    }
+
+    std::size_t m_up;
+    std::size_t m_down;
+    std::size_t m_ntaps;
+    std::size_t m_phase_len;
+    std::vector<R> m_phases;
+
+    // The last m_phase_len - 1 input samples, followed by a chunk of input
+    std::vector<T> m_buf;
+
+    // Upsampled time of the next output, relative to the first sample of
+    // the next block
+    std::size_t m_t = 0;
+
+    std::size_t m_nin = 0;
+    std::size_t m_nout = 0;
+}; // class UpFirDn
+
+//---------------------------------------------------------------------------------
+// upfirdn
+//---------------------------------------------------------------------------------
+
+template <class Array, typename T>
+auto upfirdn(const Array &h,
+             const std::vector<T> &x,
+             std::size_t up = 1,
+             std::size_t down = 1) {
+    if (x.empty()) {
+        return std::vector<T>{};
+    }
+
+    UpFirDn<T> filt(h, up, down);
+    auto y = filt.filter(x);
+    const auto tail = filt.flush();
+    y.insert(y.end(), tail.cbegin(), tail.cend());
+    return y;
+}
+
+//---------------------------------------------------------------------------------
+// Resampler
+//
+// Streaming polyphase resampling by the rational factor up / down
+// (as scipy resample_poly).
+//
+// The outputs are delayed by half of the filter length, so that the output
+// samples are aligned with the input samples: the filter delay is removed
+// from the first outputs and flush() returns the last outputs.
+//---------------------------------------------------------------------------------
+
+template <typename T = double>
+class Resampler {
+  public:
+    using R = typename UpFirDn<T>::R;
+
+    // Low-pass filter at the lowest of the input and output Nyquist
+    // frequencies, designed with a Kaiser window of parameter beta.
+    Resampler(std::size_t up, std::size_t down, R beta = R{5})
+        : Resampler(up, down, default_filter(up, down, beta)) {}
+
+    // Anti-aliasing FIR filter h, of odd size (linear phase
+    // with an integer delay)
+    template <class Array, meta::enable_if_iterable<Array> = 0>
+    Resampler(std::size_t up, std::size_t down, const Array &h)
+        : m_up(up / std::gcd(up, down)),
+          m_down(down / std::gcd(up, down)),
+          m_filt(padded_filter(h, m_up, m_down), m_up, m_down),
+          m_delay(((h.size() - 1) / 2 + pre_padding(h.size(), m_down)) /
+                  m_down),
+          m_skip(m_delay) {}
+
+    void filter(const std::vector<T> &x, std::vector<T> &y) {
+        m_filt.filter(x, y);
+        m_nin += x.size();
+        skip_delay(y);
+    }
+
+    auto filter(const std::vector<T> &x) {
+        std::vector<T> y;
+        filter(x, y);
+        return y;
+    }
+
+    // Remaining outputs, such that the total number of outputs is
+    // ceil(n * up / down) for n input samples, then reset the resampler.
+    auto flush() {
+        const auto total = (m_nin * m_up + m_down - 1) / m_down;
+        std::vector<T> y;
+
+        if (total > m_nout) {
+            // Delayed outputs are computed by feeding zeros
+            const auto nout = total - m_nout;
+            std::vector<T> zeros((m_skip + nout) * m_down / m_up + 1, T{0});
+
+            while (y.size() < nout) {
+                auto block = m_filt.filter(zeros);
+                skip_delay(block);
+                y.insert(y.end(), block.cbegin(), block.cend());
+            }
+
+            y.resize(nout);
+        }
+
+        reset();
+        return y;
+    }
+
+    void reset() {
+        m_filt.reset();
+        m_skip = m_delay;
+        m_nin = 0;
+        m_nout = 0;
+    }
+
+    auto up() const { return m_up; }
+
+    auto down() const { return m_down; }
+
+  private:
+    std::size_t m_up;
+    std::size_t m_down;
+    UpFirDn<T> m_filt;
+
+    // Number of outputs removed to compensate for the filter delay
+    std::size_t m_delay;
+    std::size_t m_skip;
+
+    std::size_t m_nin = 0;
+    std::size_t m_nout = 0;
+
+    static auto default_filter(std::size_t up, std::size_t down, R beta) {
+        scicpp_require(up > 0 && down > 0);
+        const auto max_rate = std::max(up, down) / std::gcd(up, down);
+        // No filter is required to resample by a factor 1
+        scicpp_require(max_rate > 1);
+        const auto numtaps = 20 * max_rate + 1;
+        return firwin(numtaps,
+                      R{1} / R(max_rate),
+                      windows::kaiser<R>(numtaps, beta));
+    }
+
+    // Zeros added before the filter to align the outputs
+    static std::size_t pre_padding(std::size_t ntaps, std::size_t down) {
+        return down - ((ntaps - 1) / 2) % down;
+    }
+
+    template <class Array>
+    static auto
+    padded_filter(const Array &h, std::size_t up, std::size_t down) {
+        scicpp_require(up > 0 && down > 0);
+        scicpp_require(h.size() % 2 == 1);
+        std::vector<R> res(pre_padding(h.size(), down), R{0});
+        res.reserve(res.size() + h.size());
+
+        for (const auto v : h) {
+            res.push_back(R(v) * R(up));
+        }
+
+        return res;
+    }
+
+    void skip_delay(std::vector<T> &y) {
+        const auto n = std::min(m_skip, y.size());
+        y.erase(y.begin(), y.begin() + signed_size_t(n));
+        m_skip -= n;
+        m_nout += y.size();
+    }
+}; // class Resampler
+
+//---------------------------------------------------------------------------------
+// resample_poly
+//---------------------------------------------------------------------------------
+
+// Resample x by the factor up / down, with a Kaiser window
+// of parameter beta for the low-pass filter.
+template <typename T>
+auto resample_poly(const std::vector<T> &x,
+                   std::size_t up,
+                   std::size_t down,
+                   typename Resampler<T>::R beta = 5) {
+    scicpp_require(up > 0 && down > 0);
+
+    if (up == down) {
+        return x;
+    }
+
+    Resampler<T> resampler(up, down, beta);
+    auto y = resampler.filter(x);
+    const auto tail = resampler.flush();
+    y.insert(y.end(), tail.cbegin(), tail.cend());
+    return y;
+}
+
+// Resample x by the factor up / down, with the anti-aliasing filter h
+template <class Array,
+          typename T,
+          meta::enable_if_iterable<Array> = 0>
+auto resample_poly(const std::vector<T> &x,
+                   std::size_t up,
+                   std::size_t down,
+                   const Array &h) {
+    scicpp_require(up > 0 && down > 0);
+
+    if (up == down) {
+        return x;
+    }
+
+    Resampler<T> resampler(up, down, h);
+    auto y = resampler.filter(x);
+    const auto tail = resampler.flush();
+    y.insert(y.end(), tail.cbegin(), tail.cend());
+    return y;
+}
+
+//---------------------------------------------------------------------------------
+// decimate
+//
+// Downsample by the factor q after an anti-aliasing FIR filter of order n
+// (Hamming window, cutoff at the output Nyquist frequency).
+// The default order is 20 * q (as scipy with ftype='fir').
+//---------------------------------------------------------------------------------
+
+template <typename T>
+auto decimate(const std::vector<T> &x,
+              std::size_t q,
+              int n = -1,
+              bool zero_phase = true) {
+    using R = typename Resampler<T>::R;
+    scicpp_require(q > 0);
+
+    const auto order = n < 0 ? 20 * q : std::size_t(n);
+    const auto h = firwin(order + 1, R{1} / R(q));
+
+    if (zero_phase) {
+        return resample_poly(x, 1, q, h);
+    }
+
+    // Causal filter, as lfilter followed by downsampling
+    auto y = upfirdn(h, x, 1, q);
+    y.resize((x.size() + q - 1) / q);
+    return y;
+}
+
+} // namespace scicpp::signal
+
+#endif // SCICPP_SIGNAL_RESAMPLING
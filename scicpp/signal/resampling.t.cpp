@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
+
+#include "resampling.hpp"
+
+#include "scicpp/core/equal.hpp"
+#include "scicpp/core/random.hpp"
+#include "scicpp/signal/convolve.hpp"
+
+#include <cmath>
+#include <complex>
+
+namespace scicpp::signal {
+
+namespace {
+
+// x[n] = cos(0.3 n) + 0.1 n
+auto resampling_signal(std::size_t n) {
+    std::vector<double> x(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] = std::cos(0.3 * double(i)) + 0.1 * double(i);
+    }
+
+    return x;
+}
+
+auto max_error(const std::vector<double> &x, const std::vector<double> &y) {
+    REQUIRE(x.size() == y.size());
+    double res = 0.0;
+
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        res = std::max(res, std::abs(x[i] - y[i]));
+    }
+
+    return res;
+}
+
+} // namespace
+
+TEST_CASE("upfirdn") {
+    const auto x = resampling_signal(7);
+    const std::array h{1., 2., 3., 4., 5.};
+
+    REQUIRE(almost_equal<4>(upfirdn(h, x, 3, 2),
+                            {1.0, 3.0, 7.110672978251213, 5.246681571412102,
+                             3.076006844729035, 6.969898011089722,
+                             4.4487976275593315, 2.287073263430021,
+                             4.953263175718774, 2.655746711977725,
+                             1.1183937159207396, 1.863989526534566}));
+    REQUIRE(almost_equal<4>(upfirdn(h, x),
+                            convolve(x, std::vector(h.cbegin(), h.cend()))));
+    REQUIRE(upfirdn(h, std::vector<double>{}, 3, 2).empty());
+
+    SECTION("Streaming") {
+        const auto xl = random::rand<double>(10000);
+        const auto h_long = random::rand<double>(37);
+
+        for (auto [up, down] :
+             {std::pair{1U, 1U}, {1U, 10U}, {3U, 2U}, {7U, 1U}}) {
+            const auto expected = upfirdn(h_long, xl, up, down);
+
+            UpFirDn filt(h_long, up, down);
+            std::vector<double> y, block_res;
+            std::size_t n0 = 0;
+
+            for (std::size_t len : {1U, 7U, 100U, 0U, 5000U, 4892U}) {
+                const std::vector<double> block(
+                    xl.cbegin() + signed_size_t(n0),
+                    xl.cbegin() + signed_size_t(n0 + len));
+                filt.filter(block, block_res);
+                y.insert(y.end(), block_res.cbegin(), block_res.cend());
+                n0 += len;
+            }
+
+            const auto tail = filt.flush();
+            y.insert(y.end(), tail.cbegin(), tail.cend());
+            REQUIRE(max_error(y, expected) < 1E-12);
+        }
+    }
+
+    SECTION("Complex signal") {
+        using namespace std::complex_literals;
+        const std::vector<std::complex<double>> xc{1.0 + 2.0i, -1.0i, 3.0};
+        const auto y = upfirdn(h, xc, 2, 3);
+        REQUIRE(y.size() == 3);
+        REQUIRE(almost_equal(y[0], 1.0 + 2.0i));
+        REQUIRE(almost_equal(y[1], 4.0 + 6.0i));
+        REQUIRE(almost_equal(y[2], 9.0 - 5.0i));
+    }
+}
+
+TEST_CASE("resample_poly") {
+    const auto x = resampling_signal(40);
+
+    REQUIRE(max_error(resample_poly(x, 3, 2),
+                      {1.0006061735537772, 1.1405725772111024,
+                       0.9942553289766553, 1.0259571462431825,
+                       0.9950125188906819, 0.8505384492724314,
+                       0.7628198755859544, 0.6492288353793887,
+                       0.49445446814095606, 0.3730238855380138,
+                       0.25417852689635256, 0.14101610952165483,
+                       0.06264423473269376, 0.009337349772477067,
+                       -0.01041996171446288, 0.01001356968345473,
+                       0.06631519259754029, 0.16494492557820792,
+                       0.30342540069427676, 0.473861067986417,
+                       0.6785487771164895, 0.9102906384902391,
+                       1.1581496108128044, 1.4208195697323944,
+                       1.6885219006952334, 1.9499837246123786,
+                       2.202305338950322, 2.4361687223756, 2.642597550874377,
+                       2.8198552007456206, 2.9619646635928105,
+                       3.0638857321105104, 3.1275858000220356,
+                       3.152142179644022, 3.136524764727842, 3.087842563637309,
+                       3.010174897539596, 2.904984323444972,
+                       2.7843535261306362, 2.6555641781514985,
+                       2.519992724512251, 2.392980718387456,
+                       2.2820938527849886, 2.1858831883646483,
+                       2.120286500668761, 2.090135955707854, 2.099635843849053,
+                       2.1205477785496156, 2.216655007841052,
+                       2.3652793009085347, 2.4532988781119203,
+                       2.6873623691070123, 2.9827133359669293,
+                       3.045860990011415, 3.40773452068826, 3.858270906639138,
+                       3.678934573581573, 4.196032849609077, 5.072812162520397,
+                       3.17722289955456}) < 1E-12);
+    REQUIRE(max_error(resample_poly(x, 4, 10),
+                      {0.7217188447789111, 1.0558673237385232,
+                       0.5315166671645036, 0.14494212555208308,
+                       -0.006296630123951457, 0.4380129522043503,
+                       1.2824419804964775, 2.2715733881179494,
+                       2.950686392679584, 3.1634155973901272,
+                       2.818696318819632, 2.4125995926516084,
+                       2.0165358678990177, 2.418584115160957,
+                       2.8374894974776987, 4.374183315372063}) < 1E-12);
+    REQUIRE(array_equal(resample_poly(x, 2, 2), x));
+
+    SECTION("Streaming") {
+        const auto xl = random::rand<double>(10000);
+        const auto expected = resample_poly(xl, 2, 3);
+
+        Resampler resampler(2, 3);
+        std::vector<double> y, block_res;
+        std::size_t n0 = 0;
+
+        for (std::size_t len : {1U, 7U, 100U, 0U, 5000U, 4892U}) {
+            const std::vector<double> block(
+                xl.cbegin() + signed_size_t(n0),
+                xl.cbegin() + signed_size_t(n0 + len));
+            resampler.filter(block, block_res);
+            y.insert(y.end(), block_res.cbegin(), block_res.cend());
+            n0 += len;
+        }
+
+        const auto tail = resampler.flush();
+        y.insert(y.end(), tail.cbegin(), tail.cend());
+        REQUIRE(max_error(y, expected) < 1E-12);
+    }
+}
+
+TEST_CASE("decimate") {
+    const auto x = resampling_signal(40);
+
+    REQUIRE(max_error(decimate(x, 4),
+                      {0.6609997495622987, 0.854932994792463,
+                       0.006859467714015182, 0.35036465304056646,
+                       1.639990297819974, 3.0278506817411914,
+                       2.923871079597431, 2.4166990696064934,
+                       2.0034234409138465, 3.8318844122351825}) < 1E-12);
+    REQUIRE(max_error(decimate(x, 3, 12),
+                      {0.6912186767755643, 0.933260056006114,
+                       0.37696471059106884, 0.012508218228752302,
+                       0.3196878127943296, 1.2930701202568557,
+                       2.4230528352428937, 3.0815215860357097,
+                       2.9971943686623668, 2.4609223590755565,
+                       2.1055795417590963, 2.427116295588921,
+                       3.551610288842485, 2.905410854473928}) < 1E-12);
+    REQUIRE(max_error(decimate(x, 4, -1, false),
+                      {-7.807593012848752e-19, -0.0017665236260751207,
+                       0.002316892715595138, -0.004475331289909523,
+                       0.006247793768589645, -0.014430584512061867,
+                       0.01701347359702676, -0.03174918929787771,
+                       0.048020996814149175, -0.09850203187646056}) < 1E-12);
+}
+
+} // namespace scicpp::signal
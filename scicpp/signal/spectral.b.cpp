@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: MIT
 // Copyright (c) 2019-2021 Thomas Vanderbruggen <th.vanderbruggen@gmail.com>
 
+#include "goertzel.hpp"
 #include "spectral.hpp"
 
 #include "scicpp/core.hpp"
@@ -43,4 +44,31 @@ NONIUS_BENCHMARK("signal::spectrum 16 threads", [](nonius::chronometer meter) {
                     .window(scicpp::signal::windows::hann<double>(65536))
                     .nthreads(16);
     meter.measure([&]() { return spec.welch(x); });
-})
\ No newline at end of file
+})
+NONIUS_BENCHMARK("signal::Goertzel (65536, 8 freqs)",
+                 [](nonius::chronometer meter) {
+                     const auto x = scicpp::random::randn<double>(65536);
+                     scicpp::signal::Goertzel<double> goertzel(
+                         {50., 60., 100., 120., 150., 180., 250., 300.},
+                         10000.0);
+                     std::vector<std::complex<double>> y;
+
+                     meter.measure([&]() {
+                         goertzel(x, y);
+                         return y.size();
+                     });
+                 })
+
+NONIUS_BENCHMARK("signal::SlidingDFT (65536, 8 freqs)",
+                 [](nonius::chronometer meter) {
+                     const auto x = scicpp::random::randn<double>(65536);
+                     scicpp::signal::SlidingDFT<double> sdft(
+                         10000,
+                         {50., 60., 100., 120., 150., 180., 250., 300.},
+                         10000.0);
+
+                     meter.measure([&]() {
+                         sdft.push(x);
+                         return sdft.values().size();
+                     });
+                 })
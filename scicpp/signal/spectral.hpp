@@ -8,7 +8,7 @@
 #include "scicpp/core/maths.hpp"
 #include "scicpp/core/meta.hpp"
 #include "scicpp/core/range.hpp"
-#include "scicpp/core/stats.hpp"
+#include "scicpp/core/thread_pool.hpp"
 #include "scicpp/core/units/quantity.hpp"
 #include "scicpp/core/units/units.hpp"
 #include "scicpp/core/utils.hpp"
@@ -18,8 +18,9 @@
 #include <algorithm>
 #include <complex>
 #include <cstdlib>
-#include <mutex>
-#include <thread>
+#include <functional>
+#include <iterator>
+#include <numeric>
 #include <tuple>
 #include <type_traits>
 #include <vector>
@@ -30,6 +31,18 @@ enum SpectrumScaling : int { NONE, DENSITY, SPECTRUM };
 
 enum SpectrumSides : int { ONESIDED, TWOSIDED };
 
+enum SpectrumAverage : int { MEAN, MEDIAN, TRIMMED_MEAN };
+
+// Detrending policies of the segments, applied before the window.
+// A user policy is a functor f(seg) detrending the std::vector seg in place.
+namespace detrend {
+
+struct None {};     // No detrending
+struct Constant {}; // Subtract the mean
+struct Linear {};   // Subtract the least-squares line
+
+} // namespace detrend
+
 namespace detail {
 
 // Array dimensionless element type
@@ -44,6 +57,13 @@ struct element_type {
 template <class Array>
 using element_type_t = typename element_type<Array>::type;
 
+// Array real element type (can be a physical quantity)
+template <class Array>
+using scalar_type_t =
+    std::conditional_t<meta::is_complex_v<meta::value_type_t<Array>>,
+                       meta::value_type_t<meta::value_type_t<Array>>,
+                       meta::value_type_t<Array>>;
+
 // Convert vector of quantity to values
 template <typename Array, meta::enable_if_iterable<Array> = 0>
 constexpr auto value(Array &&x) {
@@ -56,9 +76,91 @@ constexpr auto to_quantity(Array &&x) {
     return map([&](auto a) { return Qty(a); }, std::forward<Array>(x));
 }
 
+// res += x, without temporary
+template <typename T>
+scicpp_target_clones void add_inplace(std::vector<T> &res, const std::vector<T> &x) {
+    scicpp_require(res.size() == x.size());
+    std::transform(
+        res.cbegin(), res.cend(), x.cbegin(), res.begin(), std::plus<>());
+}
+
+// seg = (seg - offset - slope * k) * window, for the n values of a segment
+template <typename SegTp, typename T>
+scicpp_target_clones void detrend_window(SegTp *seg,
+                                         const T *window,
+                                         std::size_t n,
+                                         SegTp offset,
+                                         SegTp slope) {
+    for (std::size_t k = 0; k < n; ++k) {
+        seg[k] = (seg[k] - (offset + slope * T(k))) * window[k];
+    }
+}
+
+// Number of values trimmed at each end for n segments
+inline std::size_t average_ntrim(SpectrumAverage average,
+                                 std::size_t n,
+                                 long double trim) {
+    if (average == MEDIAN) {
+        return (n - 1) / 2;
+    } else if (average == TRIMMED_MEAN) {
+        return std::size_t(trim * static_cast<long double>(n));
+    } else {
+        return 0;
+    }
+}
+
+// Expected value of the mean of the order statistics ntrim + 1 to
+// n - ntrim of n exponential values of mean 1 (the periodogram of a
+// Gaussian noise): E[X_(i)] = H(n) - H(n - i), H being the harmonic numbers.
+// This is scipy's median bias for ntrim = (n - 1) / 2.
+template <typename T>
+scicpp_const T average_bias(std::size_t n, std::size_t ntrim) {
+    long double h = 0; // H(n) - H(n - i)
+    long double sum = 0;
+
+    for (std::size_t i = 1; i <= n - ntrim; ++i) {
+        h += 1.0L / static_cast<long double>(n - i + 1);
+
+        if (i > ntrim) {
+            sum += h;
+        }
+    }
+
+    return T(sum / static_cast<long double>(n - 2 * ntrim));
+}
+
+// Mean of the n values at first, without the ntrim smallest and
+// the ntrim largest ones. The values are reordered.
+template <typename T>
+T trimmed_mean(T *first, std::size_t n, std::size_t ntrim) {
+    scicpp_require(2 * ntrim < n);
+
+    if (ntrim == 0) {
+        return std::accumulate(first, first + n, T{0}) / T(n);
+    }
+
+    const auto last = first + n;
+    std::nth_element(first, first + ntrim, last);
+
+    // Median
+    if (n - 2 * ntrim == 1) {
+        return first[ntrim];
+    } else if (n - 2 * ntrim == 2) {
+        return (first[ntrim] + *std::min_element(first + ntrim + 1, last)) /
+               T{2};
+    }
+
+    std::nth_element(first + ntrim, last - ntrim, last);
+    const auto sum = std::accumulate(first + ntrim, last - ntrim, T{0});
+    return sum / T(n - 2 * ntrim);
+}
+
 } // namespace detail
 
-template <typename T = double>
+template <typename T, typename EltTp, typename Detrend>
+class StreamingSpectrum;
+
+template <typename T = double, typename Detrend = detrend::Constant>
 class Spectrum {
   public:
     Spectrum() = default;
@@ -91,6 +193,18 @@ class Spectrum {
         return *this;
     }
 
+    // Average of the segment spectra in welch and csd: MEAN (the default),
+    // MEDIAN, or TRIMMED_MEAN without the fraction trim of the lowest and of
+    // the highest values at each frequency.
+    // Medians and trimmed means are divided by their bias for a Gaussian
+    // noise, as in scipy.
+    auto average(SpectrumAverage average, T trim = T{0.1}) {
+        scicpp_require(trim >= T{0} && trim < T{0.5});
+        m_average = average;
+        m_trim = trim;
+        return *this;
+    }
+
     auto window(const std::vector<T> &window) {
         m_window = window;
         set_parameters();
@@ -109,6 +223,15 @@ class Spectrum {
         return *this;
     }
 
+    // Detrending of the segments: detrend::Constant (the default),
+    // detrend::None, detrend::Linear or a user functor.
+    // The policy is part of the type, so the detrending is fused at compile
+    // time with the window multiplication.
+    template <class Policy>
+    auto detrend(Policy policy) const {
+        return Spectrum<T, Policy>(*this, std::move(policy));
+    }
+
     // -------------------------------------------------------------------------
     // Spectrum computations
     // -------------------------------------------------------------------------
@@ -163,10 +286,10 @@ class Spectrum {
 
         if constexpr (meta::is_complex_v<EltTp>) {
             psd = detail::to_quantity<RetTp>(normalize<scaling, TWOSIDED>(
-                welch_impl(std::size_t(m_nperseg), x, fft_func)));
+                welch_impl<TWOSIDED>(std::size_t(m_nperseg), x)));
         } else {
             psd = detail::to_quantity<RetTp>(normalize<scaling, ONESIDED>(
-                welch_impl(std::size_t(m_nperseg) / 2 + 1, x, rfft_func)));
+                welch_impl<ONESIDED>(std::size_t(m_nperseg) / 2 + 1, x)));
         }
 
         if constexpr (return_freqs) {
@@ -234,11 +357,11 @@ class Spectrum {
             if constexpr (meta::is_complex_v<EltTp>) {
                 csd = detail::to_quantity<std::complex<RetTp>>(
                     normalize<scaling, TWOSIDED>(
-                        welch2_impl(std::size_t(m_nperseg), x, y, fft_func)));
+                        welch2_impl<TWOSIDED>(std::size_t(m_nperseg), x, y)));
             } else {
                 csd = detail::to_quantity<std::complex<RetTp>>(
-                    normalize<scaling, ONESIDED>(welch2_impl(
-                        std::size_t(m_nperseg) / 2 + 1, x, y, rfft_func)));
+                    normalize<scaling, ONESIDED>(welch2_impl<ONESIDED>(
+                        std::size_t(m_nperseg) / 2 + 1, x, y)));
             }
 
             if constexpr (return_freqs) {
@@ -255,42 +378,294 @@ class Spectrum {
         }
     }
 
+    // Cross spectral density matrix of C channels.
+    //
+    // Returns a C x C x nfreqs row-major array S such that
+    // S[(i * C + j) * nfreqs + f] is the CSD Pij(f) of channels i and j.
+    // S is Hermitian: Pji = conj(Pij), and Pii is the PSD of channel i.
+    //
+    // Each segment of each channel is transformed once, and the matrix is
+    // accumulated in parallel over frequency blocks.
+    template <SpectrumScaling scaling = DENSITY,
+              bool return_freqs = true,
+              typename Array>
+    auto csd_matrix(const std::vector<Array> &channels) {
+        static_assert(meta::is_iterable_v<Array>);
+        using EltTp = detail::element_type_t<Array>;
+
+        const auto nchans = channels.size();
+        const auto len = nchans == 0 ? 0 : channels[0].size();
+
+        for (const auto &x : channels) {
+            scicpp_require(x.size() == len);
+        }
+
+        return csd_matrix_impl<scaling, return_freqs, EltTp>(
+            nchans, len, [&](auto c, auto i) {
+                return std::tuple{
+                    channels[c].cbegin() + i * (m_nperseg - m_noverlap),
+                    signed_size_t(1)};
+            });
+    }
+
+    // Interleaved multichannel buffer:
+    // x[n * nchans + c] is the n-th sample of channel c.
+    template <SpectrumScaling scaling = DENSITY,
+              bool return_freqs = true,
+              typename Array>
+    auto csd_matrix(const Array &x, std::size_t nchans) {
+        static_assert(meta::is_iterable_v<Array>);
+        using EltTp = detail::element_type_t<Array>;
+        scicpp_require(nchans > 0);
+        scicpp_require(x.size() % nchans == 0);
+
+        const auto stride = signed_size_t(nchans);
+
+        return csd_matrix_impl<scaling, return_freqs, EltTp>(
+            nchans, x.size() / nchans, [&](auto c, auto i) {
+                return std::tuple{x.cbegin() +
+                                      i * (m_nperseg - m_noverlap) * stride +
+                                      signed_size_t(c),
+                                  stride};
+            });
+    }
+
     template <typename Array1, typename Array2>
     auto coherence(const Array1 &x, const Array2 &y) {
-        using namespace scicpp::operators;
         scicpp_require(x.size() == y.size());
 
-        auto [freqs, Pxy] = csd<NONE>(x, y);
-        auto Pxx = std::get<1>(welch<NONE>(x));
-        auto Pyy = std::get<1>(welch<NONE>(y));
+        // Return type: dimensionless
+        using Tp1 = detail::scalar_type_t<Array1>;
+        using Tp2 = detail::scalar_type_t<Array2>;
+        using RetTp =
+            decltype(Tp1{} * Tp2{} * Tp1{} * Tp2{} / (Tp1{} * Tp1{}) /
+                     (Tp2{} * Tp2{}));
 
-        scicpp_require(Pxy.size() == Pxx.size());
-        scicpp_require(Pxy.size() == Pyy.size());
+        if (unlikely(x.empty())) {
+            return std::tuple{empty<T>(), empty<RetTp>()};
+        }
+
+        const auto [freqs, nfft, P] = joint_spectra(x, y);
+        std::vector<RetTp> Cxy(nfft);
+
+        for (std::size_t k = 0; k < nfft; ++k) {
+            Cxy[k] = RetTp(std::norm(P[k]) / P[nfft + k].real() /
+                           P[2 * nfft + k].real());
+        }
 
-        return std::tuple{
-            freqs, norm(std::move(Pxy)) / std::move(Pxx) / std::move(Pyy)};
+        return std::tuple{freqs, Cxy};
     }
 
     template <typename Array1, typename Array2>
     auto tfestimate(const Array1 &x, const Array2 &y) {
-        using namespace scicpp::operators;
         scicpp_require(x.size() == y.size());
 
-        auto [freqs, Pyx] = csd<NONE>(y, x);
-        auto Pxx = welch<NONE, false>(x);
-        return std::tuple{freqs, std::move(Pyx) / std::move(Pxx)};
+        // Return type: Y / X
+        using Tp1 = detail::scalar_type_t<Array1>;
+        using Tp2 = detail::scalar_type_t<Array2>;
+        using RetTp = decltype(Tp2{} * Tp1{} / (Tp1{} * Tp1{}));
+
+        if (unlikely(x.empty())) {
+            return std::tuple{empty<T>(), empty<std::complex<RetTp>>()};
+        }
+
+        const auto [freqs, nfft, P] = joint_spectra(x, y);
+        std::vector<std::complex<RetTp>> Txy(nfft);
+
+        for (std::size_t k = 0; k < nfft; ++k) {
+            // Pyx / Pxx
+            const auto Tk = std::conj(P[k]) / P[nfft + k].real();
+            Txy[k] = std::complex(RetTp(Tk.real()), RetTp(Tk.imag()));
+        }
+
+        return std::tuple{freqs, Txy};
     }
 
-  private:
-    static constexpr signed_size_t dflt_nperseg = 256;
-    static constexpr auto rfft_func = [](auto v) { return rfft(v); };
-    static constexpr auto fft_func = [](auto v) { return fft(v); };
+    // Short-time Fourier transform.
+    //
+    // Zxx is a row-major nseg x nfreqs array: the i-th row holds the
+    // spectrum of the i-th windowed segment, scaled by 1 / sum(window).
+    // Segments are not detrended.
+    template <bool return_freqs_times = true, typename Array>
+    auto stft(const Array &x) {
+        using EltTp = detail::element_type_t<Array>;
+
+        std::vector<std::complex<T>> Zxx;
+        stft(x, Zxx);
+
+        if constexpr (return_freqs_times) {
+            return std::tuple{
+                get_freqs<EltTp>(), get_times(x.size()), std::move(Zxx)};
+        } else {
+            return Zxx;
+        }
+    }
+
+    // Zxx is resized to nseg x nfreqs, its memory is reused
+    // if its capacity is large enough.
+    template <typename Array>
+    void stft(const Array &x, std::vector<std::complex<T>> &Zxx) {
+        using EltTp = detail::element_type_t<Array>;
+        constexpr auto sides = meta::is_complex_v<EltTp> ? TWOSIDED : ONESIDED;
+
+        const auto nfft = get_nfft<sides>();
+        const auto scale = T{1} / std::sqrt(m_s1);
+
+        transform_segments<false>(
+            x, Zxx, nfft, [&](const auto &seg, auto row) {
+                segment_fft<sides>(seg, row);
+
+                for (std::size_t k = 0; k < nfft; ++k) {
+                    row[k] *= scale;
+                }
+            });
+    }
+
+    // Power spectral density (or power spectrum) of each segment.
+    //
+    // Sxx is a row-major nseg x nfreqs array.
+    template <SpectrumScaling scaling = DENSITY,
+              bool return_freqs_times = true,
+              typename Array>
+    auto spectrogram(const Array &x) {
+        using EltTp = detail::element_type_t<Array>;
+
+        std::vector<T> Sxx;
+        spectrogram<scaling>(x, Sxx);
+
+        if constexpr (return_freqs_times) {
+            return std::tuple{
+                get_freqs<EltTp>(), get_times(x.size()), std::move(Sxx)};
+        } else {
+            return Sxx;
+        }
+    }
+
+    template <SpectrumScaling scaling = DENSITY, typename Array>
+    void spectrogram(const Array &x, std::vector<T> &Sxx) {
+        using EltTp = detail::element_type_t<Array>;
+        constexpr auto sides = meta::is_complex_v<EltTp> ? TWOSIDED : ONESIDED;
+
+        const auto nfft = get_nfft<sides>();
+        const auto scale =
+            normalize<scaling, sides>(std::vector<T>(nfft, T{1}));
 
-    // detrend = "constant" => Substract mean
-    static constexpr auto detrend = [](auto &&x) {
+        transform_segments<true>(
+            x, Sxx, nfft, [&](const auto &seg, auto row) {
+                const auto seg_fft = row_fft(nfft);
+                segment_fft<sides>(seg, seg_fft);
+
+                for (std::size_t k = 0; k < nfft; ++k) {
+                    row[k] = std::norm(seg_fft[k]) * scale[k];
+                }
+            });
+    }
+
+    // Inverse short-time Fourier transform.
+    //
+    // Overlap-add the inverse FFTs of the rows of Zxx weighted by the window,
+    // and normalize by the overlap-added squared window.
+    // Zxx must be computed with the same parameters using stft.
+    template <bool input_onesided = true, bool return_times = true>
+    auto istft(const std::vector<std::complex<T>> &Zxx) {
         using namespace scicpp::operators;
-        return std::move(x) - stats::mean(x);
-    };
+        using OutTp = std::conditional_t<input_onesided, T, std::complex<T>>;
+
+        std::vector<OutTp> x;
+        istft<input_onesided>(Zxx, x);
+
+        if constexpr (return_times) {
+            return std::tuple{arange(T{0}, T(x.size())) / m_fs, std::move(x)};
+        } else {
+            return x;
+        }
+    }
+
+    // x is resized to the length of the signal, its memory is reused
+    // if its capacity is large enough.
+    template <bool input_onesided = true, typename OutTp>
+    void istft(const std::vector<std::complex<T>> &Zxx,
+               std::vector<OutTp> &x) {
+        static_assert(
+            std::is_same_v<OutTp,
+                           std::conditional_t<input_onesided, T, std::complex<T>>>,
+            "Output must be real for a one-sided input, complex otherwise");
+
+        const auto nfft = get_nfft<(input_onesided ? ONESIDED : TWOSIDED)>();
+        scicpp_require(Zxx.size() % nfft == 0);
+
+        const auto nseg = signed_size_t(Zxx.size() / nfft);
+        const auto nstep = m_nperseg - m_noverlap;
+        scicpp_require(nstep > 0);
+
+        if (unlikely(nseg == 0)) {
+            x.clear();
+            return;
+        }
+
+        const auto nperseg = std::size_t(m_nperseg);
+        const auto scale = std::sqrt(m_s1);
+        // Inverse FFTs are computed in parallel by batches of frames
+        const auto nbatch = std::min(nseg, signed_size_t(64));
+        auto frames = std::vector<OutTp>(std::size_t(nbatch) * nperseg);
+
+        x.assign(std::size_t(m_nperseg + (nseg - 1) * nstep), OutTp{0});
+
+        for (signed_size_t i0 = 0; i0 < nseg; i0 += nbatch) {
+            const auto nb = std::min(nbatch, nseg - i0);
+
+            global_thread_pool().parallel_for(
+                nb,
+                [&](signed_size_t b) {
+                    auto frame = frames.data() + std::size_t(b) * nperseg;
+                    segment_ifft<input_onesided>(
+                        Zxx.data() + std::size_t(i0 + b) * nfft, frame);
+
+                    for (std::size_t k = 0; k < nperseg; ++k) {
+                        frame[k] *= scale * m_window[k];
+                    }
+                },
+                std::max(m_nthreads, std::size_t(1)));
+
+            // Overlap-add in segment order
+            for (signed_size_t b = 0; b < nb; ++b) {
+                const auto frame = frames.data() + std::size_t(b) * nperseg;
+                const auto offset = std::size_t((i0 + b) * nstep);
+
+                for (std::size_t k = 0; k < nperseg; ++k) {
+                    x[offset + k] += frame[k];
+                }
+            }
+        }
+
+        // Normalize by the overlap-added squared window,
+        // computed on the fly to avoid a signal-long buffer.
+        for (signed_size_t n = 0; n < signed_size_t(x.size()); ++n) {
+            const auto i_first =
+                n < m_nperseg ? 0 : (n - m_nperseg) / nstep + 1;
+            const auto i_last = std::min(nseg - 1, n / nstep);
+            T wss{0};
+
+            for (auto i = i_first; i <= i_last; ++i) {
+                wss += std::norm(m_window[std::size_t(n - i * nstep)]);
+            }
+
+            if (wss > T{1E-10}) {
+                x[std::size_t(n)] /= wss;
+            }
+        }
+    }
+
+  private:
+    template <typename, typename, typename>
+    friend class StreamingSpectrum;
+
+    template <typename, typename>
+    friend class Spectrum;
+
+    static constexpr signed_size_t dflt_nperseg = 256;
+    static constexpr signed_size_t max_accumulators = 16;
+    static constexpr std::size_t freq_block = 256;
 
     T m_fs = T{1};
     std::vector<T> m_window = windows::hann<T>(dflt_nperseg);
@@ -300,6 +675,23 @@ class Spectrum {
     bool m_use_dflt_overlap = true;
     signed_size_t m_noverlap = m_nperseg / 2;
     std::size_t m_nthreads = 0;
+    SpectrumAverage m_average = MEAN;
+    T m_trim = T{0.1};
+    Detrend m_detrend{};
+
+    template <typename OtherDetrend>
+    Spectrum(const Spectrum<T, OtherDetrend> &spec, Detrend policy)
+        : m_fs(spec.m_fs),
+          m_window(spec.m_window),
+          m_s1(spec.m_s1),
+          m_s2(spec.m_s2),
+          m_nperseg(spec.m_nperseg),
+          m_use_dflt_overlap(spec.m_use_dflt_overlap),
+          m_noverlap(spec.m_noverlap),
+          m_nthreads(spec.m_nthreads),
+          m_average(spec.m_average),
+          m_trim(spec.m_trim),
+          m_detrend(std::move(policy)) {}
 
     auto get_nperseg() { return signed_size_t(m_window.size()); }
 
@@ -324,95 +716,551 @@ class Spectrum {
         }
     }
 
-    template <class Func>
-    auto compute_segments_multithread(signed_size_t nseg, Func func) {
-        std::vector<std::thread> threads_pool(m_nthreads);
-        signed_size_t i = 0;
+    template <SpectrumSides sides>
+    auto get_nfft() const {
+        return sides == TWOSIDED ? std::size_t(m_nperseg)
+                                 : std::size_t(m_nperseg) / 2 + 1;
+    }
+
+    // Time at the center of each segment
+    auto get_times(std::size_t size) {
+        using namespace scicpp::operators;
+
+        const auto nseg =
+            signed_size_t(size) < m_nperseg ? 0 : get_nseg(size);
+        return (T(m_nperseg) / T{2} +
+                T(m_nperseg - m_noverlap) * arange(T{0}, T(nseg))) /
+               m_fs;
+    }
+
+    // Per-thread FFT buffer of size nfft
+    static auto row_fft(std::size_t nfft) {
+        thread_local std::vector<std::complex<T>> buffer;
+        buffer.resize(nfft);
+        return buffer.data();
+    }
+
+    // Call process(seg, row) for each segment of x in parallel, where seg is
+    // the windowed segment and row points to the i-th row of the row-major
+    // nseg x ncols array res.
+    // The segment buffers are allocated once per thread, not per segment.
+    template <bool apply_detrend,
+              typename Array,
+              typename ResTp,
+              typename Process>
+    void transform_segments(const Array &x,
+                            std::vector<ResTp> &res,
+                            std::size_t ncols,
+                            Process process) {
+        using SegTp = detail::element_type_t<Array>;
+
+        const auto nseg =
+            signed_size_t(x.size()) < m_nperseg ? 0 : get_nseg(x.size());
+        res.resize(std::size_t(nseg) * ncols);
+
+        global_thread_pool().parallel_for(
+            nseg,
+            [&](signed_size_t i) {
+                thread_local std::vector<SegTp> seg;
+                seg.resize(m_window.size());
+
+                window_strided_segment<apply_detrend>(
+                    x.cbegin() + i * (m_nperseg - m_noverlap), 1, seg);
+                process(seg, res.data() + std::size_t(i) * ncols);
+            },
+            std::max(m_nthreads, std::size_t(1)));
+    }
+
+    // Segments are split into at most max_accumulators blocks of consecutive
+    // segments. Each block is summed into its own buffer, without locking,
+    // then the buffers are reduced pairwise in a fixed order.
+    // The blocks only depend on the number of segments, so the summation
+    // order, and hence the result, doesn't depend on the number of threads.
+    // make_accumulator returns a function acc(i, res) adding the spectrum
+    // of the i-th segment to res. It is called once per block, so the
+    // segment buffers are allocated once per block and not per segment.
+    template <typename Tp, class MakeAccumulator>
+    auto compute_spectrum(std::size_t nfft,
+                          signed_size_t nseg,
+                          MakeAccumulator make_accumulator) {
+        using namespace scicpp::operators;
+
+        const auto nblocks = std::min(nseg, max_accumulators);
+        auto acc = std::vector<std::vector<Tp>>(std::size_t(nblocks));
+
+        const auto accumulate_block = [&](signed_size_t b) {
+            auto &res = acc[std::size_t(b)];
+            res.assign(nfft, utils::set_zero<Tp>());
+            auto accumulate_segment = make_accumulator();
+
+            for (auto i = b * nseg / nblocks; i < (b + 1) * nseg / nblocks;
+                 ++i) {
+                accumulate_segment(i, res);
+            }
+        };
 
-        while (i < nseg) {
-            for (auto &thrd : threads_pool) {
-                thrd = std::thread(func, i);
-                ++i;
+        global_thread_pool().parallel_for(nblocks,
+                                          accumulate_block,
+                                          std::max(m_nthreads, std::size_t(1)),
+                                          1);
 
-                if (i >= nseg) {
-                    break;
+        for (signed_size_t step = 1; step < nblocks; step *= 2) {
+            for (signed_size_t b = 0; b + step < nblocks; b += 2 * step) {
+                detail::add_inplace(acc[std::size_t(b)],
+                                    acc[std::size_t(b + step)]);
+            }
+        }
+
+        return std::move(acc[0]) / T(nseg);
+    }
+
+    // Median or trimmed mean of the segment spectra.
+    // process(i, row) writes the spectrum of the i-th segment at row.
+    //
+    // The spectra are computed by batches of segments in parallel, and
+    // transposed into a frequency-major array of nfft x nseg values
+    // (one array per real and imaginary part), so that the selection over
+    // the segments of each frequency runs on contiguous values,
+    // in parallel over frequency blocks.
+    template <typename Tp, class Process>
+    auto robust_spectrum(std::size_t nfft,
+                         signed_size_t nseg,
+                         Process process) {
+        constexpr std::size_t nparts = meta::is_complex_v<Tp> ? 2 : 1;
+        constexpr signed_size_t nbatch = 64;
+
+        const auto n = std::size_t(nseg);
+        const auto nthreads = std::max(m_nthreads, std::size_t(1));
+        const auto nfreq_blocks =
+            signed_size_t((nfft + freq_block - 1) / freq_block);
+
+        auto values = std::vector<T>(nparts * nfft * n);
+        auto rows =
+            std::vector<Tp>(std::size_t(std::min(nseg, nbatch)) * nfft);
+
+        for (signed_size_t i0 = 0; i0 < nseg; i0 += nbatch) {
+            const auto nb = std::min(nbatch, nseg - i0);
+
+            global_thread_pool().parallel_for(
+                nb,
+                [&](signed_size_t b) {
+                    process(i0 + b, rows.data() + std::size_t(b) * nfft);
+                },
+                nthreads);
+
+            // Blocked transpose
+            global_thread_pool().parallel_for(
+                nfreq_blocks,
+                [&](signed_size_t fb) {
+                    const auto f0 = std::size_t(fb) * freq_block;
+                    const auto f1 = std::min(f0 + freq_block, nfft);
+
+                    for (auto f = f0; f < f1; ++f) {
+                        auto *col = values.data() + f * n + std::size_t(i0);
+
+                        for (std::size_t b = 0; b < std::size_t(nb); ++b) {
+                            const auto z = rows[b * nfft + f];
+
+                            if constexpr (nparts == 2) {
+                                col[b] = z.real();
+                                col[nfft * n + b] = z.imag();
+                            } else {
+                                col[b] = z;
+                            }
+                        }
+                    }
+                },
+                nthreads,
+                1);
+        }
+
+        const auto ntrim = detail::average_ntrim(
+            m_average, n, static_cast<long double>(m_trim));
+        const auto bias = detail::average_bias<T>(n, ntrim);
+        auto res = std::vector<Tp>(nfft);
+
+        global_thread_pool().parallel_for(
+            nfreq_blocks,
+            [&](signed_size_t fb) {
+                const auto f0 = std::size_t(fb) * freq_block;
+                const auto f1 = std::min(f0 + freq_block, nfft);
+
+                for (auto f = f0; f < f1; ++f) {
+                    auto *col = values.data() + f * n;
+                    const auto avg = detail::trimmed_mean(col, n, ntrim);
+
+                    if constexpr (nparts == 2) {
+                        const auto avg_imag = detail::trimmed_mean(
+                            col + nfft * n, n, ntrim);
+                        res[f] = Tp(avg, avg_imag) / bias;
+                    } else {
+                        res[f] = avg / bias;
+                    }
+                }
+            },
+            nthreads,
+            1);
+
+        return res;
+    }
+
+    scicpp_pure auto get_nseg(std::size_t size) const {
+        scicpp_require(signed_size_t(size) >= m_nperseg);
+        return 1 + (signed_size_t(size) - m_nperseg) / (m_nperseg - m_noverlap);
+    }
+
+    // Fused segment pipeline:
+    // Read the i-th segment of a in place, and write the detrended and
+    // windowed values directly into the FFT input buffer seg.
+    template <typename Array, typename SegTp>
+    void window_segment(const Array &a,
+                        signed_size_t i,
+                        std::vector<SegTp> &seg) const {
+        window_strided_segment(
+            a.cbegin() + i * (m_nperseg - m_noverlap), 1, seg);
+    }
+
+    // Segment starting at first, with samples spaced by stride
+    // (ex. a channel of an interleaved multichannel buffer).
+    //
+    // The samples are read in a single pass, which also accumulates the
+    // sums needed by the constant and linear detrending, then detrended
+    // and windowed in a second pass.
+    template <bool apply_detrend = true, typename InputIt, typename SegTp>
+    void window_strided_segment(InputIt first,
+                                signed_size_t stride,
+                                std::vector<SegTp> &seg) const {
+        scicpp_require(seg.size() == m_window.size());
+
+        constexpr bool constant = std::is_same_v<Detrend, detrend::Constant>;
+        constexpr bool linear = std::is_same_v<Detrend, detrend::Linear>;
+        const auto n = seg.size();
+
+        if constexpr (!apply_detrend ||
+                      std::is_same_v<Detrend, detrend::None>) {
+            for (std::size_t k = 0; k < n; ++k) {
+                seg[k] = SegTp(units::value(first[signed_size_t(k) * stride])) *
+                         m_window[k];
+            }
+        } else if constexpr (constant || linear) {
+            // Least-squares line a + b (k - c), with c = (n - 1) / 2:
+            // a = sum(x[k]) / n, b = sum((k - c) x[k]) / sum((k - c)^2)
+            const auto c = T(n - 1) / T{2};
+            SegTp sum_x{0};
+            SegTp sum_kx{0};
+
+            for (std::size_t k = 0; k < n; ++k) {
+                const auto x =
+                    SegTp(units::value(first[signed_size_t(k) * stride]));
+                seg[k] = x;
+                sum_x += x;
+
+                if constexpr (linear) {
+                    sum_kx += (T(k) - c) * x;
                 }
             }
 
-            for (auto &thrd : threads_pool) {
-                if (thrd.joinable()) {
-                    thrd.join();
+            const auto a = sum_x / T(n);
+            auto b = SegTp{0};
+
+            if constexpr (linear) {
+                if (n > 1) {
+                    b = sum_kx / (T(n) * (T(n) * T(n) - T{1}) / T{12});
                 }
             }
+
+            detail::detrend_window(
+                seg.data(), m_window.data(), n, a - b * c, b);
+        } else {
+            for (std::size_t k = 0; k < n; ++k) {
+                seg[k] = SegTp(units::value(first[signed_size_t(k) * stride]));
+            }
+
+            m_detrend(seg);
+            detail::detrend_window(
+                seg.data(), m_window.data(), n, SegTp{0}, SegTp{0});
         }
     }
 
-    template <typename Tp, class SegPsdFunc>
-    auto compute_spectrum(std::size_t nfft,
-                          signed_size_t nseg,
-                          SegPsdFunc get_segment_psd) {
-        using namespace scicpp::operators;
+    template <SpectrumSides sides, typename SegTp>
+    static void segment_fft(const std::vector<SegTp> &seg,
+                            std::vector<std::complex<T>> &seg_fft) {
+        if (unlikely(seg.size() == 1)) {
+            seg_fft.resize(1);
+            seg_fft[0] = seg[0];
+        } else if constexpr (sides == TWOSIDED) {
+            fft_inplace(seg.cbegin(), seg.cend(), seg_fft);
+        } else {
+            rfft_inplace(seg.cbegin(), seg.cend(), seg_fft);
+        }
+    }
 
-        auto res = zeros<Tp>(nfft);
+    // Write the spectrum of seg at dst
+    template <SpectrumSides sides, typename SegTp>
+    static void segment_fft(const std::vector<SegTp> &seg,
+                            std::complex<T> *dst) {
+        const auto n = signed_size_t(seg.size());
+
+        if (unlikely(n == 1)) {
+            dst[0] = seg[0];
+        } else if constexpr (sides == TWOSIDED) {
+            detail::fft_engine<T>().fwd(dst, seg.data(), n);
+        } else {
+            detail::fft_engine<T, true>().fwd(dst, seg.data(), n);
+        }
+    }
 
-        if (m_nthreads <= 1 || nseg == 1) {
-            for (signed_size_t i = 0; i < nseg; ++i) {
-                res = std::move(res) + get_segment_psd(i);
+    // Write the inverse FFT of a segment spectrum at dst
+    template <bool onesided, typename OutTp>
+    void segment_ifft(const std::complex<T> *src, OutTp *dst) const {
+        if (unlikely(m_nperseg == 1)) {
+            if constexpr (onesided) {
+                dst[0] = src[0].real();
+            } else {
+                dst[0] = src[0];
             }
+        } else if constexpr (onesided) {
+            detail::fft_engine<T, true>().inv(dst, src, m_nperseg);
         } else {
-            std::mutex mtx;
-            compute_segments_multithread(nseg, [&](auto i) {
-                auto seg_spectrum = get_segment_psd(i);
+            detail::fft_engine<T>().inv(dst, src, m_nperseg);
+        }
+    }
 
-                {
-                    std::lock_guard guard(mtx);
-                    res = std::move(res) + std::move(seg_spectrum);
-                }
-            });
+    template <SpectrumSides sides, typename Array>
+    auto welch_impl(std::size_t nfft, const Array &a) {
+        using SegTp = detail::element_type_t<Array>;
+
+        if (m_average != MEAN) {
+            return robust_spectrum<T>(
+                nfft, get_nseg(a.size()), [&](auto i, auto row) {
+                    thread_local std::vector<SegTp> seg;
+                    seg.resize(m_window.size());
+                    const auto seg_fft = row_fft(nfft);
+
+                    window_segment(a, i, seg);
+                    segment_fft<sides>(seg, seg_fft);
+
+                    for (std::size_t k = 0; k < nfft; ++k) {
+                        row[k] = std::norm(seg_fft[k]);
+                    }
+                });
         }
 
-        return std::move(res) / T(nseg);
+        return compute_spectrum<T>(nfft, get_nseg(a.size()), [&]() {
+            return [&, seg = std::vector<SegTp>(m_window.size()),
+                    seg_fft = std::vector<std::complex<T>>(nfft)](
+                       auto i, auto &res) mutable {
+                window_segment(a, i, seg);
+                segment_fft<sides>(seg, seg_fft);
+                std::transform(res.cbegin(),
+                               res.cend(),
+                               seg_fft.cbegin(),
+                               res.begin(),
+                               [](auto r, auto z) { return r + std::norm(z); });
+            };
+        });
     }
 
-    template <typename Array, typename FFTFunc>
-    auto welch_impl(std::size_t nfft, const Array &a, FFTFunc &&fftfunc) {
-        const auto asize = signed_size_t(a.size());
-        const auto nstep = m_nperseg - m_noverlap;
-        const auto nseg = 1 + (asize - m_nperseg) / nstep;
+    template <SpectrumSides sides, typename Array1, typename Array2>
+    auto welch2_impl(std::size_t nfft, const Array1 &x, const Array2 &y) {
+        using SegTp1 = detail::element_type_t<Array1>;
+        using SegTp2 = detail::element_type_t<Array2>;
+        scicpp_require(x.size() == y.size());
 
-        return compute_spectrum<T>(nfft, nseg, [&](auto i) {
-            using namespace scicpp::operators;
+        if (m_average != MEAN) {
+            return robust_spectrum<std::complex<T>>(
+                nfft, get_nseg(x.size()), [&](auto i, auto row) {
+                    thread_local std::vector<SegTp1> seg_x;
+                    thread_local std::vector<SegTp2> seg_y;
+                    thread_local std::vector<std::complex<T>> fft_y;
+                    seg_x.resize(m_window.size());
+                    seg_y.resize(m_window.size());
+                    fft_y.resize(nfft);
+                    const auto fft_x = row_fft(nfft);
+
+                    window_segment(x, i, seg_x);
+                    segment_fft<sides>(seg_x, fft_x);
+                    window_segment(y, i, seg_y);
+                    segment_fft<sides>(seg_y, fft_y.data());
+
+                    for (std::size_t k = 0; k < nfft; ++k) {
+                        row[k] = std::conj(fft_x[k]) * fft_y[k];
+                    }
+                });
+        }
 
-            auto seg = utils::subvector(a, m_nperseg, i * nstep);
-            scicpp_require(seg.size() == m_window.size());
-            return norm(
-                fftfunc(detrend(detail::value(std::move(seg))) * m_window));
-        });
+        return compute_spectrum<std::complex<T>>(
+            nfft, get_nseg(x.size()), [&]() {
+                return [&,
+                        seg_x = std::vector<SegTp1>(m_window.size()),
+                        seg_y = std::vector<SegTp2>(m_window.size()),
+                        fft_x = std::vector<std::complex<T>>(nfft),
+                        fft_y = std::vector<std::complex<T>>(nfft)](
+                           auto i, auto &res) mutable {
+                    window_segment(x, i, seg_x);
+                    segment_fft<sides>(seg_x, fft_x);
+                    window_segment(y, i, seg_y);
+                    segment_fft<sides>(seg_y, fft_y);
+
+                    for (std::size_t k = 0; k < res.size(); ++k) {
+                        res[k] += std::conj(fft_x[k]) * fft_y[k];
+                    }
+                };
+            });
     }
 
-    template <typename Array1, typename Array2, typename FFTFunc>
-    auto welch2_impl(std::size_t nfft,
-                     const Array1 &x,
-                     const Array2 &y,
-                     FFTFunc &&fftfunc) {
-        using namespace scicpp::operators;
+    // get_segment(c, i) returns the iterator to the first sample of the i-th
+    // segment of channel c, and the spacing between samples.
+    //
+    // Segments are processed by batches of about 64 FFTs computed in
+    // parallel. The upper triangle is then accumulated in parallel over
+    // frequency blocks, each frequency summing the segments in order,
+    // so the result doesn't depend on the number of threads.
+    template <SpectrumScaling scaling,
+              bool return_freqs,
+              typename EltTp,
+              typename GetSegment>
+    auto csd_matrix_impl(std::size_t nchans,
+                         std::size_t len,
+                         GetSegment get_segment) {
+        constexpr auto sides = meta::is_complex_v<EltTp> ? TWOSIDED : ONESIDED;
+        const auto nfft = sides == TWOSIDED ? std::size_t(m_nperseg)
+                                            : std::size_t(m_nperseg) / 2 + 1;
+
+        if (unlikely(nchans == 0 || len == 0)) {
+            if constexpr (return_freqs) {
+                return std::tuple{empty<T>(), empty<std::complex<T>>()};
+            } else {
+                return empty<std::complex<T>>();
+            }
+        }
+
+        const auto nseg = get_nseg(len);
+        const auto C = nchans;
+        const auto nbatch =
+            std::min(nseg, std::max(signed_size_t(1), 64 / signed_size_t(C)));
+        const auto nfreq_blocks =
+            signed_size_t((nfft + freq_block - 1) / freq_block);
+        const auto nthreads = std::max(m_nthreads, std::size_t(1));
+
+        auto S = zeros<std::complex<T>>(C * C * nfft);
+        auto ffts = std::vector<std::vector<std::complex<T>>>(
+            C * std::size_t(nbatch), std::vector<std::complex<T>>(nfft));
+
+        for (signed_size_t i0 = 0; i0 < nseg; i0 += nbatch) {
+            const auto nb = std::min(nbatch, nseg - i0);
+
+            // FFT of each channel of each segment of the batch
+            global_thread_pool().parallel_for(
+                nb * signed_size_t(C),
+                [&](auto idx) {
+                    thread_local std::vector<EltTp> seg;
+                    seg.resize(m_window.size());
+
+                    const auto c = std::size_t(idx) % C;
+                    const auto i = i0 + idx / signed_size_t(C);
+                    const auto [first, stride] = get_segment(c, i);
+                    window_strided_segment(first, stride, seg);
+                    segment_fft<sides>(seg, ffts[std::size_t(idx)]);
+                },
+                nthreads);
+
+            // Accumulate the upper triangle, by blocks of frequencies
+            global_thread_pool().parallel_for(
+                nfreq_blocks,
+                [&](auto fb) {
+                    const auto f0 = std::size_t(fb) * freq_block;
+                    const auto f1 = std::min(f0 + freq_block, nfft);
+
+                    for (std::size_t i = 0; i < C; ++i) {
+                        for (std::size_t j = i; j < C; ++j) {
+                            auto *Sij = S.data() + (i * C + j) * nfft;
+
+                            for (std::size_t b = 0; b < std::size_t(nb); ++b) {
+                                const auto &Xi = ffts[b * C + i];
+                                const auto &Xj = ffts[b * C + j];
+
+                                for (auto f = f0; f < f1; ++f) {
+                                    Sij[f] += std::conj(Xi[f]) * Xj[f];
+                                }
+                            }
+                        }
+                    }
+                },
+                nthreads,
+                1);
+        }
+
+        // Average, normalize and fill the lower triangle
+        const auto scale = normalize<scaling, sides>(
+            std::vector<T>(nfft, T{1} / T(nseg)));
+
+        for (std::size_t i = 0; i < C; ++i) {
+            for (std::size_t j = i; j < C; ++j) {
+                auto *Sij = S.data() + (i * C + j) * nfft;
+                auto *Sji = S.data() + (j * C + i) * nfft;
+
+                for (std::size_t f = 0; f < nfft; ++f) {
+                    Sij[f] *= scale[f];
+                    Sji[f] = std::conj(Sij[f]);
+                }
+            }
+        }
+
+        if constexpr (return_freqs) {
+            return std::tuple{get_freqs<EltTp>(), S};
+        } else {
+            return S;
+        }
+    }
+
+    // Joint estimation of the cross and auto spectra of x and y,
+    // using a single FFT per channel and per segment.
+    //
+    // Returns the spectra packed in a single vector: [Pxy | Pxx | Pyy].
+    // They are not normalized: the scaling and the one-sided spectrum factors
+    // cancel out in the coherence and transfer function estimates.
+    template <SpectrumSides sides, typename Array1, typename Array2>
+    auto welch3_impl(std::size_t nfft, const Array1 &x, const Array2 &y) {
+        using SegTp1 = detail::element_type_t<Array1>;
+        using SegTp2 = detail::element_type_t<Array2>;
         scicpp_require(x.size() == y.size());
 
-        const auto asize = signed_size_t(x.size());
-        const auto nstep = m_nperseg - m_noverlap;
-        const auto nseg = 1 + (asize - m_nperseg) / nstep;
-
-        return compute_spectrum<std::complex<T>>(nfft, nseg, [&](auto i) {
-            using namespace scicpp::operators;
-
-            auto seg_x = utils::subvector(x, m_nperseg, i * nstep);
-            scicpp_require(seg_x.size() == m_window.size());
-            auto seg_y = utils::subvector(y, m_nperseg, i * nstep);
-            scicpp_require(seg_y.size() == m_window.size());
-            return conj(fftfunc(detrend(detail::value(std::move(seg_x))) *
-                                m_window)) *
-                   fftfunc(detrend(detail::value(std::move(seg_y))) * m_window);
-        });
+        return compute_spectrum<std::complex<T>>(
+            3 * nfft, get_nseg(x.size()), [&]() {
+                return [&,
+                        seg_x = std::vector<SegTp1>(m_window.size()),
+                        seg_y = std::vector<SegTp2>(m_window.size()),
+                        fft_x = std::vector<std::complex<T>>(nfft),
+                        fft_y = std::vector<std::complex<T>>(nfft)](
+                           auto i, auto &res) mutable {
+                    window_segment(x, i, seg_x);
+                    segment_fft<sides>(seg_x, fft_x);
+                    window_segment(y, i, seg_y);
+                    segment_fft<sides>(seg_y, fft_y);
+
+                    for (std::size_t k = 0; k < nfft; ++k) {
+                        res[k] += std::conj(fft_x[k]) * fft_y[k];
+                        res[nfft + k] += std::norm(fft_x[k]);
+                        res[2 * nfft + k] += std::norm(fft_y[k]);
+                    }
+                };
+            });
+    }
+
+    template <typename Array1, typename Array2>
+    auto joint_spectra(const Array1 &x, const Array2 &y) {
+        if constexpr (meta::is_complex_v<detail::element_type_t<Array1>> ||
+                      meta::is_complex_v<detail::element_type_t<Array2>>) {
+            const auto nfft = std::size_t(m_nperseg);
+            return std::tuple{get_freqs<std::complex<T>>(),
+                              nfft,
+                              welch3_impl<TWOSIDED>(nfft, x, y)};
+        } else {
+            const auto nfft = std::size_t(m_nperseg) / 2 + 1;
+            return std::tuple{
+                get_freqs<T>(), nfft, welch3_impl<ONESIDED>(nfft, x, y)};
+        }
     }
 
     template <SpectrumScaling scaling, SpectrumSides sides, typename SpecTp>
@@ -421,12 +1269,16 @@ class Spectrum {
 
         if constexpr (sides == ONESIDED) {
             v = 2.0 * std::move(v);
-            // Don't find why in scipy code, but need it to match scipy result
-            v.front() *= 0.5;
 
-            if (!(m_nperseg % 2)) {
-                // Last point is unpaired Nyquist freq point, don't double
-                v.back() *= 0.5;
+            if (!v.empty()) {
+                // Don't find why in scipy code,
+                // but need it to match scipy result
+                v.front() *= 0.5;
+
+                if (!(m_nperseg % 2)) {
+                    // Last point is unpaired Nyquist freq point, don't double
+                    v.back() *= 0.5;
+                }
             }
         }
 
@@ -440,6 +1292,142 @@ class Spectrum {
     }
 }; // class Spectrum
 
+//---------------------------------------------------------------------------------
+// StreamingSpectrum
+//
+// Incremental Welch estimator: samples are pushed by blocks of any size,
+// each segment is processed as soon as it is complete, and only the samples
+// of the next incomplete segment are kept in memory.
+//
+// The averaged spectrum of the segments processed so far is available at
+// any time. Averaging is either cumulative (alpha = 0), which gives the same
+// result than Spectrum::welch on the whole record, or exponential with
+// smoothing factor alpha in (0, 1] for live monitoring.
+//
+// EltTp is the element type of the signal: T or std::complex<T>.
+//---------------------------------------------------------------------------------
+
+template <typename T = double,
+          typename EltTp = T,
+          typename Detrend = detrend::Constant>
+class StreamingSpectrum {
+  public:
+    static_assert(std::is_same_v<EltTp, T> ||
+                  std::is_same_v<EltTp, std::complex<T>>);
+
+    explicit StreamingSpectrum(
+        const Spectrum<T, Detrend> &spec = Spectrum<T, Detrend>{},
+        T alpha = T{0})
+        : m_spec(spec), m_alpha(alpha) {
+        scicpp_require(m_alpha >= T{0} && m_alpha <= T{1});
+        scicpp_require(m_spec.m_noverlap < m_spec.m_nperseg);
+        m_buffer.reserve(2 * m_seg.size());
+    }
+
+    // Push a new block of samples
+    template <typename Array>
+    void push(const Array &x) {
+        static_assert(meta::is_iterable_v<Array>);
+        static_assert(std::is_same_v<detail::element_type_t<Array>, EltTp>);
+
+        std::transform(
+            x.cbegin(), x.cend(), std::back_inserter(m_buffer), [](auto v) {
+                return EltTp(units::value(v));
+            });
+
+        const auto nperseg = m_spec.m_nperseg;
+        const auto nstep = m_spec.m_nperseg - m_spec.m_noverlap;
+        signed_size_t i = 0;
+
+        for (; i * nstep + nperseg <= signed_size_t(m_buffer.size()); ++i) {
+            m_spec.window_segment(m_buffer, i, m_seg);
+            m_spec.template segment_fft<sides>(m_seg, m_seg_fft);
+            accumulate();
+        }
+
+        // Drop the samples that won't be used by any future segment
+        m_buffer.erase(m_buffer.begin(), m_buffer.begin() + i * nstep);
+    }
+
+    // Averaged spectrum of the segments processed so far
+    template <SpectrumScaling scaling = DENSITY, bool return_freqs = true>
+    auto welch() {
+        using namespace scicpp::operators;
+
+        std::vector<T> psd;
+
+        if (likely(m_nseg > 0)) {
+            auto avg = m_acc;
+
+            if (m_alpha <= T{0}) {
+                avg = std::move(avg) / T(m_nseg);
+            }
+
+            psd = m_spec.template normalize<scaling, sides>(std::move(avg));
+        }
+
+        if constexpr (return_freqs) {
+            if (unlikely(m_nseg == 0)) {
+                return std::tuple{empty<T>(), psd};
+            }
+
+            return std::tuple{m_spec.template get_freqs<EltTp>(), psd};
+        } else {
+            return psd;
+        }
+    }
+
+    // Number of segments processed so far
+    auto nseg() const { return m_nseg; }
+
+    // Discard the buffered samples and the averaged spectrum
+    void reset() {
+        m_buffer.clear();
+        m_acc.assign(m_acc.size(), T{0});
+        m_nseg = 0;
+    }
+
+  private:
+    static constexpr auto sides =
+        meta::is_complex_v<EltTp> ? TWOSIDED : ONESIDED;
+
+    Spectrum<T, Detrend> m_spec;
+    T m_alpha;
+    std::vector<EltTp> m_buffer{};
+    std::vector<EltTp> m_seg = std::vector<EltTp>(m_spec.m_window.size());
+    std::vector<std::complex<T>> m_seg_fft{};
+    std::vector<T> m_acc = std::vector<T>(nfft(), T{0});
+    signed_size_t m_nseg = 0;
+
+    std::size_t nfft() const {
+        const auto nperseg = std::size_t(m_spec.m_nperseg);
+        return sides == TWOSIDED ? nperseg : nperseg / 2 + 1;
+    }
+
+    void accumulate() {
+        scicpp_require(m_seg_fft.size() == m_acc.size());
+
+        if (m_alpha > T{0} && m_nseg > 0) {
+            std::transform(m_acc.cbegin(),
+                           m_acc.cend(),
+                           m_seg_fft.cbegin(),
+                           m_acc.begin(),
+                           [a = m_alpha](auto acc, auto z) {
+                               return acc + a * (std::norm(z) - acc);
+                           });
+        } else {
+            std::transform(
+                m_acc.cbegin(),
+                m_acc.cend(),
+                m_seg_fft.cbegin(),
+                m_acc.begin(),
+                [](auto acc, auto z) { return acc + std::norm(z); });
+        }
+
+        ++m_nseg;
+    }
+}; // class StreamingSpectrum
+
 } // namespace scicpp::signal
 
 #endif // SCICPP_SIGNAL_SPECTRAL
\ No newline at end of file
@@ -21,6 +21,7 @@ using namespace std::literals;
 #include "scicpp/core/random.t.cpp"
 #include "scicpp/core/range.t.cpp"
 #include "scicpp/core/stats.t.cpp"
+#include "scicpp/core/thread_pool.t.cpp"
 #include "scicpp/core/tuple.t.cpp"
 #include "scicpp/core/units/arithmetic.t.cpp"
 #include "scicpp/core/units/maths.t.cpp"
@@ -31,7 +32,13 @@ using namespace std::literals;
 #include "scicpp/linalg/utils.t.cpp"
 #include "scicpp/polynomials/polynomial.t.cpp"
 #include "scicpp/signal/convolve.t.cpp"
+#include "scicpp/signal/czt.t.cpp"
 #include "scicpp/signal/fft.t.cpp"
+#include "scicpp/signal/filtering.t.cpp"
+#include "scicpp/signal/fir_filter_design.t.cpp"
+#include "scicpp/signal/goertzel.t.cpp"
+#include "scicpp/signal/mixed_radix_fft.t.cpp"
+#include "scicpp/signal/resampling.t.cpp"
 #include "scicpp/signal/spectral.t.cpp"
 #include "scicpp/signal/waveforms.t.cpp"
 #include "scicpp/signal/windows.t.cpp"
\ No newline at end of file